@@ -9,33 +9,54 @@
 #include "config.hpp"
 
 // Mathematics
+#include "arena.hpp"
 #include "connection.hpp"
 #include "curvature.hpp"
 #include "deriv.hpp"
 #include "eigen_jacobi.hpp"
 #include "field.hpp"
 #include "integrators.hpp"
+#include "lattice_field.hpp"
 #include "linalg.hpp"
+#include "linalg_batch.hpp"
 #include "metric.hpp"
+#include "mlp_field.hpp"
 #include "numeric.hpp"
+#include "optim.hpp"
+#include "parallel.hpp"
+#include "qmc.hpp"
 #include "quadform.hpp"
+#include "ricci_flow.hpp"
 #include "rng.hpp"
 #include "tetrad.hpp"
+#include "traj_batch.hpp"
 #include "units.hpp"
 
 // Physics
 #include "einstein_fit.hpp"
+#include "metric_fit.hpp"
+#include "poisson.hpp"
 #include "stress_energy.hpp"
+#include "stress_mesh.hpp"
 
 // Diagnostics
+#include "accum.hpp"
+#include "arrow_ipc.hpp"
+#include "async_export.hpp"
+#include "diag_graph.hpp"
 #include "export.hpp"
 #include "grid.hpp"
+#include "incremental.hpp"
 #include "overlay.hpp"
 #include "palette.hpp"
 #include "ppm.hpp"
+#include "qmc_integrate.hpp"
 #include "slicer.hpp"
+#include "text_writer.hpp"
+#include "tiled_grid.hpp"
 
 // Audits
+#include "pd_batch.hpp"
 #include "pd_proxy.hpp"
 #include "time_dilation.hpp"
 
@@ -0,0 +1,262 @@
+#include "rslm_capi.h"
+
+#include <memory>
+#include <vector>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "field.hpp"
+#include "connection.hpp"
+#include "integrators.hpp"
+#include "grid.hpp"
+#include "stress_energy.hpp"
+#include "parallel.hpp"
+
+struct rslm_field     { std::unique_ptr<rslm::field::IMetricField> impl; };
+struct rslm_potential { std::unique_ptr<rslm::field::IPotential> impl; };
+
+namespace {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+
+struct CallbackField final : rslm::field::IMetricField {
+    rslm_metric_fn fn;
+    void* user;
+    CallbackField(rslm_metric_fn f, void* u) : fn(f), user(u) {}
+    sym4 g(const vec4& x) const override {
+        double xi[4] = { double(x.v[0]), double(x.v[1]), double(x.v[2]), double(x.v[3]) };
+        double go[16] = {};
+        fn(xi, go, user);
+        sym4 S;
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) S.m[r][c] = real(go[r*4 + c]);
+        return S;
+    }
+};
+
+// ---- Strided element access --------------------------------------------------
+
+inline char* addr(const rslm_array& a, int64_t i0, int64_t i1 = 0, int64_t i2 = 0, int64_t i3 = 0) {
+    return static_cast<char*>(a.data) + i0*a.strides[0]
+         + (a.ndim > 1 ? i1*a.strides[1] : 0)
+         + (a.ndim > 2 ? i2*a.strides[2] : 0)
+         + (a.ndim > 3 ? i3*a.strides[3] : 0);
+}
+
+inline real load(const rslm_array& a, int64_t i0, int64_t i1 = 0, int64_t i2 = 0, int64_t i3 = 0) {
+    const char* p = addr(a, i0, i1, i2, i3);
+    return a.dtype == RSLM_F32 ? real(*reinterpret_cast<const float*>(p))
+                               : real(*reinterpret_cast<const double*>(p));
+}
+
+inline void store(const rslm_array& a, real v, int64_t i0, int64_t i1 = 0, int64_t i2 = 0, int64_t i3 = 0) {
+    char* p = addr(a, i0, i1, i2, i3);
+    if (a.dtype == RSLM_F32) *reinterpret_cast<float*>(p) = float(v);
+    else                     *reinterpret_cast<double*>(p) = double(v);
+}
+
+inline vec4 load_vec4(const rslm_array& a, int64_t k) {
+    return vec4{ load(a,k,0), load(a,k,1), load(a,k,2), load(a,k,3) };
+}
+inline void store_vec4(const rslm_array& a, int64_t k, const vec4& v) {
+    for (int i=0;i<4;++i) store(a, v.v[i], k, i);
+}
+
+/**
+ * Validate an array view: ndim, dtype, trailing dims (-1 = any).
+ * Returns RSLM_OK and the leading extent in n_out.
+ */
+inline int32_t check(const rslm_array* a, int32_t ndim, std::initializer_list<int64_t> tail, int64_t* n_out) {
+    if (!a || !a->data) return RSLM_E_NULL;
+    if (a->dtype != RSLM_F32 && a->dtype != RSLM_F64) return RSLM_E_DTYPE;
+    if (a->ndim != ndim) return RSLM_E_SHAPE;
+    int d = 1;
+    for (int64_t want : tail) {
+        if (want >= 0 && a->shape[d] != want) return RSLM_E_SHAPE;
+        ++d;
+    }
+    if (a->shape[0] < 0) return RSLM_E_SHAPE;
+    if (n_out) *n_out = a->shape[0];
+    return RSLM_OK;
+}
+
+inline unsigned nthreads(int32_t t) { return t > 0 ? unsigned(t) : 0u; }
+
+template <typename Fn>
+inline int32_t guarded(Fn&& fn) {
+    try { return fn(); }
+    catch (...) { return RSLM_E_INTERNAL; }
+}
+
+} // namespace
+
+extern "C" {
+
+int32_t rslm_abi_version(void) { return RSLM_CAPI_VERSION; }
+
+const char* rslm_real_name(void) { return rslm::cfg::kRealName; }
+
+const char* rslm_status_str(int32_t status) {
+    switch (status) {
+        case RSLM_OK:         return "ok";
+        case RSLM_E_NULL:     return "null handle or array";
+        case RSLM_E_SHAPE:    return "shape mismatch";
+        case RSLM_E_DTYPE:    return "unsupported dtype";
+        case RSLM_E_ARG:      return "invalid argument";
+        case RSLM_E_INTERNAL: return "internal error";
+    }
+    return "unknown status";
+}
+
+// ---- Fields / potentials -----------------------------------------------------
+
+rslm_field* rslm_field_minkowski(void) {
+    return new (std::nothrow) rslm_field{ std::make_unique<rslm::field::MinkowskiField>() };
+}
+
+rslm_field* rslm_field_gaussian_bump(double eps) {
+    return new (std::nothrow) rslm_field{ std::make_unique<rslm::field::GaussianBumpField>(real(eps)) };
+}
+
+rslm_field* rslm_field_callback(rslm_metric_fn fn, void* user) {
+    if (!fn) return nullptr;
+    return new (std::nothrow) rslm_field{ std::make_unique<CallbackField>(fn, user) };
+}
+
+void rslm_field_free(rslm_field* f) { delete f; }
+
+rslm_potential* rslm_potential_radial(double k) {
+    return new (std::nothrow) rslm_potential{ std::make_unique<rslm::field::RadialPotential>(real(k)) };
+}
+
+void rslm_potential_free(rslm_potential* p) { delete p; }
+
+// ---- Batched kernels ----------------------------------------------------------
+
+int32_t rslm_metric_batch(const rslm_field* f, const rslm_array* x, rslm_array* g, int32_t threads) {
+    if (!f) return RSLM_E_NULL;
+    int64_t n = 0, ng = 0;
+    if (int32_t s = check(x, 2, {4}, &n)) return s;
+    if (int32_t s = check(g, 3, {4,4}, &ng)) return s;
+    if (ng != n) return RSLM_E_SHAPE;
+    return guarded([&] {
+        rslm::par::parallel_for(std::size_t(n), [&](std::size_t b, std::size_t e) {
+            for (std::size_t k=b;k<e;++k) {
+                sym4 G = f->impl->g(load_vec4(*x, int64_t(k)));
+                for (int r=0;r<4;++r) for (int c=0;c<4;++c) store(*g, G.m[r][c], int64_t(k), r, c);
+            }
+        }, nthreads(threads));
+        return int32_t(RSLM_OK);
+    });
+}
+
+int32_t rslm_christoffel_batch(const rslm_field* f, const rslm_array* x, rslm_array* gamma, int32_t threads) {
+    if (!f) return RSLM_E_NULL;
+    int64_t n = 0, ng = 0;
+    if (int32_t s = check(x, 2, {4}, &n)) return s;
+    if (int32_t s = check(gamma, 4, {4,4,4}, &ng)) return s;
+    if (ng != n) return RSLM_E_SHAPE;
+    return guarded([&] {
+        rslm::par::parallel_for(std::size_t(n), [&](std::size_t b, std::size_t e) {
+            for (std::size_t k=b;k<e;++k) {
+                auto M = rslm::conn::prepare_metric(*f->impl, load_vec4(*x, int64_t(k)));
+                auto G = rslm::conn::christoffel(M);
+                for (int mu=0;mu<4;++mu) for (int a=0;a<4;++a) for (int bb=0;bb<4;++bb)
+                    store(*gamma, G.G[mu][a][bb], int64_t(k), mu, a, bb);
+            }
+        }, nthreads(threads), 16);
+        return int32_t(RSLM_OK);
+    });
+}
+
+int32_t rslm_geodesic_step_batch(const rslm_field* f, const rslm_potential* p,
+                                 rslm_array* x, rslm_array* u, double dtau, int32_t threads) {
+    if (!f) return RSLM_E_NULL;
+    int64_t n = 0, nu = 0;
+    if (int32_t s = check(x, 2, {4}, &n)) return s;
+    if (int32_t s = check(u, 2, {4}, &nu)) return s;
+    if (nu != n) return RSLM_E_SHAPE;
+    if (!(dtau == dtau)) return RSLM_E_ARG;
+    const rslm::field::IPotential* P = p ? p->impl.get() : nullptr;
+    return guarded([&] {
+        rslm::par::parallel_for(std::size_t(n), [&](std::size_t b, std::size_t e) {
+            for (std::size_t k=b;k<e;++k) {
+                vec4 xk = load_vec4(*x, int64_t(k));
+                vec4 uk = load_vec4(*u, int64_t(k));
+                rslm::integ::geodesic_step(*f->impl, P, xk, uk, real(dtau));
+                store_vec4(*x, int64_t(k), xk);
+                store_vec4(*u, int64_t(k), uk);
+            }
+        }, nthreads(threads), 16);
+        return int32_t(RSLM_OK);
+    });
+}
+
+int32_t rslm_sample_xy(const rslm_field* f, int32_t quantity,
+                       double t0, double z0, double x0, double y0, double dx, double dy,
+                       rslm_array* out, int32_t threads) {
+    if (!f) return RSLM_E_NULL;
+    int64_t ny = 0;                                 // rows (along y)
+    if (int32_t s = check(out, 2, {-1}, &ny)) return s;
+    if (quantity != RSLM_Q_SCALAR_R && quantity != RSLM_Q_RIEMANN_FROB) return RSLM_E_ARG;
+    const int64_t nx = out->shape[1];               // columns (along x)
+    return guarded([&] {
+        rslm::par::parallel_for(std::size_t(ny), [&](std::size_t b, std::size_t e) {
+            vec4 x{real(t0), real(x0), real(y0), real(z0)};
+            for (std::size_t i=b;i<e;++i) {
+                x.v[2] = real(y0) + real(i)*real(dy);
+                for (int64_t j=0;j<nx;++j) {
+                    x.v[1] = real(x0) + real(j)*real(dx);
+                    real v = (quantity == RSLM_Q_SCALAR_R) ? rslm::diag::curv_scalar(*f->impl, x)
+                                                           : rslm::diag::curv_riemann_frob(*f->impl, x);
+                    store(*out, v, int64_t(i), j);
+                }
+            }
+        }, nthreads(threads), 1);
+        return int32_t(RSLM_OK);
+    });
+}
+
+int32_t rslm_stress_energy_batch(const rslm_field* f,
+                                 const rslm_array* ev_x, const rslm_array* ev_u,
+                                 const rslm_array* ev_E, const rslm_array* ev_m,
+                                 const rslm_ts_params* params,
+                                 const rslm_array* x, rslm_array* T, int32_t threads) {
+    if (!f || !params) return RSLM_E_NULL;
+    int64_t m = 0, mu = 0, mE = 0, mm = 0, n = 0, nT = 0;
+    if (int32_t s = check(ev_x, 2, {4}, &m))  return s;
+    if (int32_t s = check(ev_u, 2, {4}, &mu)) return s;
+    if (int32_t s = check(ev_E, 1, {}, &mE))  return s;
+    if (int32_t s = check(ev_m, 1, {}, &mm))  return s;
+    if (int32_t s = check(x, 2, {4}, &n))     return s;
+    if (int32_t s = check(T, 3, {4,4}, &nT))  return s;
+    if (mu != m || mE != m || mm != m || nT != n) return RSLM_E_SHAPE;
+    if (!(params->sigma > 0)) return RSLM_E_ARG;
+
+    return guarded([&] {
+        // Events are small next to the query batch; stress_energy_at wants them as a vector.
+        std::vector<rslm::phys::Event> evs(static_cast<std::size_t>(m));
+        for (int64_t k=0;k<m;++k) {
+            auto& e = evs[std::size_t(k)];
+            e.x = load_vec4(*ev_x, k);
+            e.u = load_vec4(*ev_u, k);
+            e.E = load(*ev_E, k);
+            e.m = load(*ev_m, k);
+        }
+        rslm::phys::TSParams P;
+        P.sigma = real(params->sigma); P.eta = real(params->eta);
+        P.kappa = real(params->kappa); P.c2  = real(params->c2);
+
+        rslm::par::parallel_for(std::size_t(n), [&](std::size_t b, std::size_t e) {
+            for (std::size_t k=b;k<e;++k) {
+                mat4 Tk = rslm::phys::stress_energy_at(*f->impl, evs, load_vec4(*x, int64_t(k)), P);
+                for (int r=0;r<4;++r) for (int c=0;c<4;++c) store(*T, Tk.m[r][c], int64_t(k), r, c);
+            }
+        }, nthreads(threads), 16);
+        return int32_t(RSLM_OK);
+    });
+}
+
+} // extern "C"
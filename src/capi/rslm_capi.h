@@ -0,0 +1,110 @@
+#pragma once
+/**
+ * RSLM Maths — capi/rslm_capi.h
+ * -----------------------------
+ * Stable C ABI over the batched kernels, for Python (ctypes/cffi) and other
+ * foreign callers. Arrays are passed as strided views, never copied:
+ *
+ *   rslm_array { data, dtype, ndim, shape[], strides[] }
+ *
+ *  - strides are in BYTES (NumPy `arr.strides` / `__array_interface__`);
+ *    DLPack callers multiply their element strides by the item size
+ *  - float32 and float64 are accepted on every argument independently;
+ *    values are converted to the library `real` lane by lane
+ *  - outputs must be preallocated by the caller with the documented shape
+ *
+ * Every entry point returns an rslm_status; no C++ exception crosses the ABI.
+ * Bump RSLM_CAPI_VERSION on any incompatible change to this header.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RSLM_CAPI_VERSION 1
+#define RSLM_MAX_DIMS 4
+
+typedef enum rslm_dtype {
+    RSLM_F32 = 0,
+    RSLM_F64 = 1
+} rslm_dtype;
+
+typedef enum rslm_status {
+    RSLM_OK          = 0,
+    RSLM_E_NULL      = 1,   /* null handle or array */
+    RSLM_E_SHAPE     = 2,   /* ndim/shape mismatch */
+    RSLM_E_DTYPE     = 3,   /* unsupported dtype */
+    RSLM_E_ARG       = 4,   /* invalid scalar argument */
+    RSLM_E_INTERNAL  = 5    /* exception inside the library */
+} rslm_status;
+
+typedef struct rslm_array {
+    void*      data;
+    int32_t    dtype;                    /* rslm_dtype */
+    int32_t    ndim;
+    int64_t    shape[RSLM_MAX_DIMS];
+    int64_t    strides[RSLM_MAX_DIMS];   /* bytes */
+} rslm_array;
+
+/* Scalar quantities for grid sampling */
+typedef enum rslm_quantity {
+    RSLM_Q_SCALAR_R      = 0,   /* Ricci scalar R */
+    RSLM_Q_RIEMANN_FROB  = 1    /* ||Riemann||_F */
+} rslm_quantity;
+
+typedef struct rslm_ts_params {
+    double sigma;
+    double eta;
+    double kappa;
+    double c2;
+} rslm_ts_params;
+
+/* Opaque handles */
+typedef struct rslm_field rslm_field;
+typedef struct rslm_potential rslm_potential;
+
+/* User metric callback: write g_{μν}(x) row-major into g_out[16]. Must be thread-safe. */
+typedef void (*rslm_metric_fn)(const double x[4], double g_out[16], void* user);
+
+int32_t     rslm_abi_version(void);
+const char* rslm_real_name(void);
+const char* rslm_status_str(int32_t status);
+
+/* ---- Fields / potentials -------------------------------------------------- */
+rslm_field*     rslm_field_minkowski(void);
+rslm_field*     rslm_field_gaussian_bump(double eps);
+rslm_field*     rslm_field_callback(rslm_metric_fn fn, void* user);
+void            rslm_field_free(rslm_field* f);
+
+rslm_potential* rslm_potential_radial(double k);
+void            rslm_potential_free(rslm_potential* p);
+
+/* ---- Batched kernels (threads = 0 → all cores) ----------------------------- */
+
+/* x: (n,4) → g: (n,4,4) */
+int32_t rslm_metric_batch(const rslm_field* f, const rslm_array* x, rslm_array* g, int32_t threads);
+
+/* x: (n,4) → gamma: (n,4,4,4), gamma[k][mu][a][b] = Γ^μ_{ab} */
+int32_t rslm_christoffel_batch(const rslm_field* f, const rslm_array* x, rslm_array* gamma, int32_t threads);
+
+/* x, u: (n,4), advanced in place by one velocity-Verlet step; p may be NULL */
+int32_t rslm_geodesic_step_batch(const rslm_field* f, const rslm_potential* p,
+                                 rslm_array* x, rslm_array* u, double dtau, int32_t threads);
+
+/* out: (ny,nx) row-major, out[i][j] at (x0 + j·dx, y0 + i·dy) and fixed (t0,z0) — as diag::sample_xy */
+int32_t rslm_sample_xy(const rslm_field* f, int32_t quantity,
+                       double t0, double z0, double x0, double y0, double dx, double dy,
+                       rslm_array* out, int32_t threads);
+
+/* events: ev_x, ev_u (m,4), ev_E, ev_m (m); queries x: (n,4) → T: (n,4,4) */
+int32_t rslm_stress_energy_batch(const rslm_field* f,
+                                 const rslm_array* ev_x, const rslm_array* ev_u,
+                                 const rslm_array* ev_E, const rslm_array* ev_m,
+                                 const rslm_ts_params* params,
+                                 const rslm_array* x, rslm_array* T, int32_t threads);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+/**
+ * RSLM Maths — arena.hpp
+ * ----------------------
+ * Monotonic bump allocator for per-step scratch in batched kernels.
+ *  - alloc<T>(n) hands out aligned, uninitialized storage for trivial types
+ *  - reset() recycles every block at once (no per-object frees)
+ *  - mark()/rollback() release everything allocated since the mark, for
+ *    helpers that borrow scratch from a caller's arena
+ *  - blocks are kept between resets, so steady-state steps never hit malloc
+ *
+ * Not thread-safe: use one Arena per thread (or per workspace).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+
+namespace rslm::mem {
+
+class Arena {
+public:
+    static constexpr std::size_t kAlign = 64;   // cache line / widest SIMD register
+
+    explicit Arena(std::size_t block_bytes = std::size_t(1) << 20) : block_bytes_(block_bytes) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&) = default;
+    Arena& operator=(Arena&&) = default;
+
+    void* allocate(std::size_t bytes, std::size_t align = kAlign) {
+        if (bytes == 0) bytes = 1;
+        while (cur_ < blocks_.size()) {
+            Block& b = blocks_[cur_];
+            std::uintptr_t base = reinterpret_cast<std::uintptr_t>(b.mem.get());
+            std::uintptr_t p = (base + b.used + (align - 1)) & ~std::uintptr_t(align - 1);
+            if (p + bytes <= base + b.size) {
+                b.used = std::size_t(p - base) + bytes;
+                used_total_ += bytes;
+                return reinterpret_cast<void*>(p);
+            }
+            ++cur_;
+        }
+        // New block: big enough for this request plus worst-case alignment slack
+        std::size_t sz = std::max(block_bytes_, bytes + align);
+        blocks_.push_back(Block{std::unique_ptr<std::byte[]>(new std::byte[sz]), sz, 0});
+        cur_ = blocks_.size() - 1;
+        return allocate(bytes, align);
+    }
+
+    template <typename T>
+    T* alloc(std::size_t n) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena only holds trivially destructible types");
+        return static_cast<T*>(allocate(n * sizeof(T), std::max(alignof(T), kAlign)));
+    }
+
+    // Value-initialized variant (zeros for arithmetic types).
+    template <typename T>
+    T* alloc_zeroed(std::size_t n) {
+        T* p = alloc<T>(n);
+        for (std::size_t i=0;i<n;++i) new (p + i) T{};
+        return p;
+    }
+
+    void reset() {
+        for (auto& b : blocks_) b.used = 0;
+        cur_ = 0;
+        used_total_ = 0;
+    }
+
+    struct Mark {
+        std::size_t block{0}, used{0}, total{0};
+    };
+
+    Mark mark() const {
+        return Mark{cur_, cur_ < blocks_.size() ? blocks_[cur_].used : 0, used_total_};
+    }
+
+    // Frees everything allocated after m; pointers handed out before m stay valid.
+    void rollback(const Mark& m) {
+        for (std::size_t i = m.block + 1; i < blocks_.size(); ++i) blocks_[i].used = 0;
+        if (m.block < blocks_.size()) blocks_[m.block].used = m.used;
+        cur_ = m.block;
+        used_total_ = m.total;
+    }
+
+    std::size_t bytes_used() const { return used_total_; }
+    std::size_t bytes_reserved() const {
+        std::size_t s = 0;
+        for (auto& b : blocks_) s += b.size;
+        return s;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> mem;
+        std::size_t size{0};
+        std::size_t used{0};
+    };
+
+    std::vector<Block> blocks_;
+    std::size_t cur_ = 0;
+    std::size_t block_bytes_;
+    std::size_t used_total_ = 0;
+};
+
+} // namespace rslm::mem
@@ -0,0 +1,191 @@
+#pragma once
+/**
+ * RSLM Maths — audits/pd_batch.hpp
+ * --------------------------------
+ * Batched PD audit + Cholesky for banks of 4×4 PD proxies \tilde g
+ * (pd_proxy_square outputs, or E Eᵀ from tetrads), stored as Sym4Batch.
+ *
+ *  - cholesky4_batch : unrolled, branch-free A = L Lᵀ across lanes; returns L,
+ *                      a PD mask and min/max diag(L) per lane (same semantics
+ *                      as cholesky4/check_pd, pivot ≤ eps ⇒ not PD)
+ *  - chol_solve_batch: x = \tilde g⁻¹ b via forward/back substitution, so the
+ *                      optimizer never forms an explicit inverse
+ *
+ * Non-PD lanes, and lanes whose factor overflows, get L = I and ok = 0, so
+ * L is always finite; the solve passes b through unchanged there (identity
+ * preconditioner fallback).
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "linalg_batch.hpp"
+
+namespace rslm::audits {
+
+using rslm::cfg::real;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+using rslm::linalg::sym_idx;
+using rslm::linalg::Sym4Batch;
+using rslm::linalg::Vec4Batch;
+
+struct PDBatchReport {
+    std::vector<std::uint8_t> ok;   // 1 if PD
+    std::vector<real> min_diagL;
+    std::vector<real> max_diagL;
+    std::size_t n_ok{0};
+
+    inline void resize(std::size_t n) { ok.assign(n, 0); min_diagL.assign(n, real(0)); max_diagL.assign(n, real(0)); }
+};
+
+// ---- Builders ----------------------------------------------------------------
+
+// \tilde g = g² for each lane (batched pd_proxy_square).
+inline void pd_proxy_square_batch(const sym4* g, std::size_t n, Sym4Batch& out) {
+    out.resize(n);
+    for (int r=0;r<4;++r) for (int c=r;c<4;++c) {
+        real* o = out.comp(r,c);
+        RSLM_VECTORIZE
+        for (std::size_t k=0;k<n;++k) {
+            const auto& G = g[k].m;
+            o[k] = G[r][0]*G[0][c] + G[r][1]*G[1][c] + G[r][2]*G[2][c] + G[r][3]*G[3][c];
+        }
+    }
+}
+
+// \tilde g = E Eᵀ from tetrads (PD by construction when E is invertible).
+inline void pd_proxy_tetrad_batch(const mat4* E, std::size_t n, Sym4Batch& out) {
+    out.resize(n);
+    for (int r=0;r<4;++r) for (int c=r;c<4;++c) {
+        real* o = out.comp(r,c);
+        RSLM_VECTORIZE
+        for (std::size_t k=0;k<n;++k) {
+            const auto& e = E[k].m;
+            o[k] = e[r][0]*e[c][0] + e[r][1]*e[c][1] + e[r][2]*e[c][2] + e[r][3]*e[c][3];
+        }
+    }
+}
+
+// ---- Cholesky ----------------------------------------------------------------
+
+inline void cholesky4_batch(const Sym4Batch& A, Sym4Batch& L, PDBatchReport& R, real eps = real(0)) {
+    const std::size_t n = A.n;
+    L.resize(n);
+    R.resize(n);
+    const real floor = std::numeric_limits<real>::min();
+
+    const real *a00=A.comp(0,0), *a10=A.comp(1,0), *a20=A.comp(2,0), *a30=A.comp(3,0),
+               *a11=A.comp(1,1), *a21=A.comp(2,1), *a31=A.comp(3,1),
+               *a22=A.comp(2,2), *a32=A.comp(3,2), *a33=A.comp(3,3);
+    real *l00=L.comp(0,0), *l10=L.comp(1,0), *l20=L.comp(2,0), *l30=L.comp(3,0),
+         *l11=L.comp(1,1), *l21=L.comp(2,1), *l31=L.comp(3,1),
+         *l22=L.comp(2,2), *l32=L.comp(3,2), *l33=L.comp(3,3);
+    std::uint8_t* ok = R.ok.data();
+    real* dmin = R.min_diagL.data();
+    real* dmax = R.max_diagL.data();
+
+    RSLM_VECTORIZE
+    for (std::size_t k=0;k<n;++k) {
+        real d0 = a00[k];
+        real s0 = std::sqrt(std::max(d0, floor));
+        real i0 = real(1)/s0;
+        real x10 = a10[k]*i0, x20 = a20[k]*i0, x30 = a30[k]*i0;
+
+        real d1 = a11[k] - x10*x10;
+        real s1 = std::sqrt(std::max(d1, floor));
+        real i1 = real(1)/s1;
+        real x21 = (a21[k] - x20*x10)*i1;
+        real x31 = (a31[k] - x30*x10)*i1;
+
+        real d2 = a22[k] - x20*x20 - x21*x21;
+        real s2 = std::sqrt(std::max(d2, floor));
+        real x32 = (a32[k] - x30*x20 - x31*x21)/s2;
+
+        real d3 = a33[k] - x30*x30 - x31*x31 - x32*x32;
+        real s3 = std::sqrt(std::max(d3, floor));
+
+        // floored pivots can still blow up the off-diagonals (1/√floor), and
+        // huge entries overflow on their own: both count as not PD
+        const real sum = s0 + s1 + s2 + s3 + x10 + x20 + x30 + x21 + x31 + x32;
+        std::uint8_t pd = std::uint8_t((d0 > eps) & (d1 > eps) & (d2 > eps) & (d3 > eps) & std::isfinite(sum));
+        const real one = real(1), zero = real(0);
+        l00[k] = pd ? s0  : one;  l10[k] = pd ? x10 : zero; l20[k] = pd ? x20 : zero; l30[k] = pd ? x30 : zero;
+        l11[k] = pd ? s1  : one;  l21[k] = pd ? x21 : zero; l31[k] = pd ? x31 : zero;
+        l22[k] = pd ? s2  : one;  l32[k] = pd ? x32 : zero; l33[k] = pd ? s3  : one;
+
+        ok[k]   = pd;
+        dmin[k] = pd ? std::min(std::min(s0,s1), std::min(s2,s3)) : real(0);
+        dmax[k] = pd ? std::max(std::max(s0,s1), std::max(s2,s3)) : real(0);
+    }
+
+    std::size_t cnt = 0;
+    for (std::size_t k=0;k<n;++k) cnt += ok[k];
+    R.n_ok = cnt;
+}
+
+// ---- Triangular solves -------------------------------------------------------
+
+// Solve L y = b (forward) for each lane.
+inline void tri_lower_solve_batch(const Sym4Batch& L, const Vec4Batch& b, Vec4Batch& y) {
+    const std::size_t n = L.n;
+    y.resize(n);
+    const real *l00=L.comp(0,0), *l10=L.comp(1,0), *l20=L.comp(2,0), *l30=L.comp(3,0),
+               *l11=L.comp(1,1), *l21=L.comp(2,1), *l31=L.comp(3,1),
+               *l22=L.comp(2,2), *l32=L.comp(3,2), *l33=L.comp(3,3);
+    const real *b0=b.c[0].data(), *b1=b.c[1].data(), *b2=b.c[2].data(), *b3=b.c[3].data();
+    real *y0=y.c[0].data(), *y1=y.c[1].data(), *y2=y.c[2].data(), *y3=y.c[3].data();
+
+    RSLM_VECTORIZE
+    for (std::size_t k=0;k<n;++k) {
+        real z0 = b0[k] / l00[k];
+        real z1 = (b1[k] - l10[k]*z0) / l11[k];
+        real z2 = (b2[k] - l20[k]*z0 - l21[k]*z1) / l22[k];
+        real z3 = (b3[k] - l30[k]*z0 - l31[k]*z1 - l32[k]*z2) / l33[k];
+        y0[k]=z0; y1[k]=z1; y2[k]=z2; y3[k]=z3;
+    }
+}
+
+// Solve Lᵀ x = y (backward) for each lane.
+inline void tri_upper_solve_batch(const Sym4Batch& L, const Vec4Batch& y, Vec4Batch& x) {
+    const std::size_t n = L.n;
+    x.resize(n);
+    const real *l00=L.comp(0,0), *l10=L.comp(1,0), *l20=L.comp(2,0), *l30=L.comp(3,0),
+               *l11=L.comp(1,1), *l21=L.comp(2,1), *l31=L.comp(3,1),
+               *l22=L.comp(2,2), *l32=L.comp(3,2), *l33=L.comp(3,3);
+    const real *y0=y.c[0].data(), *y1=y.c[1].data(), *y2=y.c[2].data(), *y3=y.c[3].data();
+    real *x0=x.c[0].data(), *x1=x.c[1].data(), *x2=x.c[2].data(), *x3=x.c[3].data();
+
+    RSLM_VECTORIZE
+    for (std::size_t k=0;k<n;++k) {
+        real z3 = y3[k] / l33[k];
+        real z2 = (y2[k] - l32[k]*z3) / l22[k];
+        real z1 = (y1[k] - l21[k]*z2 - l31[k]*z3) / l11[k];
+        real z0 = (y0[k] - l10[k]*z1 - l20[k]*z2 - l30[k]*z3) / l00[k];
+        x0[k]=z0; x1[k]=z1; x2[k]=z2; x3[k]=z3;
+    }
+}
+
+/**
+ * x = \tilde g⁻¹ b using the factor from cholesky4_batch.
+ * Lanes with ok==0 get x = b (plain gradient step instead of NaNs/garbage).
+ */
+inline void chol_solve_batch(const Sym4Batch& L, const PDBatchReport& R, const Vec4Batch& b, Vec4Batch& x) {
+    Vec4Batch y;
+    tri_lower_solve_batch(L, b, y);
+    tri_upper_solve_batch(L, y, x);
+    const std::uint8_t* ok = R.ok.data();
+    for (int i=0;i<4;++i) {
+        real* xi = x.c[i].data();
+        const real* bi = b.c[i].data();
+        RSLM_VECTORIZE
+        for (std::size_t k=0;k<x.n;++k) xi[k] = ok[k] ? xi[k] : bi[k];
+    }
+}
+
+} // namespace rslm::audits
@@ -12,15 +12,23 @@
  *
  * If u is properly normalized (g(u,u) = -1), identity holds: gamma = 1/sqrt(1-v^2).
  * This is a robust, frame-invariant way to report γ for diagnostics & windowing.
+ *
+ * Batched audits (per trajectory step) skip the cold eigensolve:
+ *  - tetrad path: t = e_0 of a tetrad E the caller already holds (Eᵀ g E = η),
+ *  - warm path:   t from a Jacobi solve warm-started at the previous eigenframe.
+ * Results land in SoA arrays (TDBatch) and fold into Accumulator/Histogram.
  */
 
 #include <cmath>
+#include <cstddef>
+#include <vector>
 #include <algorithm>
 #include "config.hpp"
 #include "linalg.hpp"
 #include "quadform.hpp"
 #include "metric.hpp"
 #include "eigen_jacobi.hpp"  // symmetric 4×4 eigen (already in tree)
+#include "accum.hpp"
 
 namespace rslm::audits {
 
@@ -80,4 +88,138 @@ inline TDReport time_dilation(const sym4& g, const vec4& u) {
     return R;
 }
 
+// ---- Batched audits ---------------------------------------------------------
+
+struct TDBatch {
+    std::vector<real> gamma, v_norm, q_u;   // SoA, one entry per (g,u) pair
+    inline void resize(std::size_t n) { gamma.resize(n); v_norm.resize(n); q_u.resize(n); }
+    inline std::size_t size() const { return gamma.size(); }
+};
+
+// Eigenframe carried between consecutive audits of one trajectory.
+// With Q = I the warm solve applies the cold solve's rotations, and a refresh
+// that does not converge within 16 rotations reruns the cold solve, so a
+// default-constructed frame gives the cold result.
+struct TDFrame {
+    mat4 Q = rslm::linalg::identity();
+    int rotations{0};                       // warm rotations spent by the last refresh
+    bool cold{false};                       // last refresh fell back to the cold solve
+};
+
+// Same as time_dilation(), but with the observer direction t supplied.
+inline TDReport time_dilation_frame(const sym4& g, const vec4& u, const vec4& t) {
+    using rslm::quad::qform;
+    TDReport R;
+    R.q_u = qform(g, u);
+    real gut = real(0);
+    for (int i=0;i<4;++i) for (int j=0;j<4;++j) gut += u.v[i] * g.m[i][j] * t.v[j];
+    R.gamma = -gut;
+    vec4 w{ u.v[0] - R.gamma*t.v[0],
+            u.v[1] - R.gamma*t.v[1],
+            u.v[2] - R.gamma*t.v[2],
+            u.v[3] - R.gamma*t.v[3] };
+    real v2 = qform(g, w) / std::max(real(1e-30), R.gamma*R.gamma);
+    R.v_norm = std::sqrt(std::max(real(0), v2));
+    return R;
+}
+
+// Timelike unit from a warm-started eigenframe (updates F in place).
+inline vec4 timelike_unit_warm(const sym4& g, TDFrame& F) {
+    vec4 evals;
+    F.rotations = rslm::eigen::jacobi_symmetric_4x4_warm(g, F.Q, evals, 16, real(1e-12), &F.cold);
+    int k = 0;
+    for (int i=1;i<4;++i) if (evals.v[i] < evals.v[k]) k = i;
+    real scale = real(1) / std::sqrt(std::max(real(1e-30), -evals.v[k]));
+    return vec4{ F.Q.m[0][k]*scale, F.Q.m[1][k]*scale, F.Q.m[2][k]*scale, F.Q.m[3][k]*scale };
+}
+
+/**
+ * Lane kernel: given observer directions t[i], write γ, |v|, g(u,u) for n lanes.
+ * Straight-line arithmetic only (no eigensolve, no logging) so it vectorizes.
+ */
+inline void time_dilation_lanes(const sym4* g, const vec4* u, const vec4* t, std::size_t n,
+                                real* gamma, real* v_norm, real* q_u) {
+    RSLM_VECTORIZE
+    for (std::size_t k=0;k<n;++k) {
+        const auto& G = g[k].m;
+        real gu[4], gt[4];
+        for (int i=0;i<4;++i) {
+            gu[i] = G[i][0]*u[k].v[0] + G[i][1]*u[k].v[1] + G[i][2]*u[k].v[2] + G[i][3]*u[k].v[3];
+            gt[i] = G[i][0]*t[k].v[0] + G[i][1]*t[k].v[1] + G[i][2]*t[k].v[2] + G[i][3]*t[k].v[3];
+        }
+        real quu = 0, qut = 0, qtt = 0;
+        for (int i=0;i<4;++i) { quu += u[k].v[i]*gu[i]; qut += u[k].v[i]*gt[i]; qtt += t[k].v[i]*gt[i]; }
+        real gam = -qut;
+        // g(w,w) with w = u - γ t, expanded: g(u,u) - 2γ g(u,t) + γ² g(t,t)
+        real gw = quu - real(2)*gam*qut + gam*gam*qtt;
+        real v2 = gw / std::max(real(1e-30), gam*gam);
+        gamma[k]  = gam;
+        v_norm[k] = std::sqrt(std::max(real(0), v2));
+        q_u[k]    = quu;
+    }
+}
+
+/** Tetrad path: observer t = e_0 = column 0 of E[i] (one tetrad per lane). */
+inline void time_dilation_batch(const sym4* g, const vec4* u, const mat4* E, std::size_t n, TDBatch& out) {
+    out.resize(n);
+    constexpr std::size_t CH = 256;
+    vec4 t[CH];
+    for (std::size_t b=0;b<n;b+=CH) {
+        const std::size_t m = std::min(CH, n - b);
+        for (std::size_t k=0;k<m;++k) {
+            const auto& e = E[b+k].m;
+            t[k] = vec4{ e[0][0], e[1][0], e[2][0], e[3][0] };
+        }
+        time_dilation_lanes(g+b, u+b, t, m, &out.gamma[b], &out.v_norm[b], &out.q_u[b]);
+    }
+}
+
+/** Warm path across trajectories: frames[i] is lane i's eigenframe, refreshed here. */
+inline void time_dilation_batch(const sym4* g, const vec4* u, TDFrame* frames, std::size_t n, TDBatch& out) {
+    out.resize(n);
+    constexpr std::size_t CH = 256;
+    vec4 t[CH];
+    for (std::size_t b=0;b<n;b+=CH) {
+        const std::size_t m = std::min(CH, n - b);
+        for (std::size_t k=0;k<m;++k) t[k] = timelike_unit_warm(g[b+k], frames[b+k]);
+        time_dilation_lanes(g+b, u+b, t, m, &out.gamma[b], &out.v_norm[b], &out.q_u[b]);
+    }
+}
+
+/** Warm path along one trajectory: consecutive steps share a single frame. */
+inline void time_dilation_path(const sym4* g, const vec4* u, std::size_t n, TDFrame& frame, TDBatch& out) {
+    out.resize(n);
+    constexpr std::size_t CH = 256;
+    vec4 t[CH];
+    for (std::size_t b=0;b<n;b+=CH) {
+        const std::size_t m = std::min(CH, n - b);
+        for (std::size_t k=0;k<m;++k) t[k] = timelike_unit_warm(g[b+k], frame);
+        time_dilation_lanes(g+b, u+b, t, m, &out.gamma[b], &out.v_norm[b], &out.q_u[b]);
+    }
+}
+
+// ---- Aggregation -------------------------------------------------------------
+
+struct TDSummary {
+    rslm::diag::Accumulator gamma, v_norm;
+    rslm::diag::Accumulator shell;          // |g(u,u) + 1|, normalization drift
+    rslm::diag::Histogram   gamma_hist, v_hist;
+
+    explicit TDSummary(real gamma_hi = real(5), std::size_t nbins = 64)
+        : gamma_hist(real(1), gamma_hi, nbins), v_hist(real(0), real(1), nbins) {}
+
+    inline void merge(const TDSummary& o) {
+        gamma.merge(o.gamma); v_norm.merge(o.v_norm); shell.merge(o.shell);
+        gamma_hist.merge(o.gamma_hist); v_hist.merge(o.v_hist);
+    }
+};
+
+inline void accumulate(const TDBatch& B, TDSummary& S) {
+    for (std::size_t k=0;k<B.size();++k) {
+        S.gamma.push(B.gamma[k]);      S.gamma_hist.push(B.gamma[k]);
+        S.v_norm.push(B.v_norm[k]);    S.v_hist.push(B.v_norm[k]);
+        S.shell.push(std::fabs(B.q_u[k] + real(1)));
+    }
+}
+
 } // namespace rslm::audits
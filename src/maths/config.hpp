@@ -42,6 +42,13 @@ using real = float;
 using real = double;
 #endif
 
+// ABI tag for compiled entry points (inline namespace), keeps float/double builds apart
+#if defined(RSLM_REAL_FLOAT)
+#  define RSLM_KERN_ABI f32
+#else
+#  define RSLM_KERN_ABI f64
+#endif
+
 // Compile-time banner
 inline constexpr const char* kRealName =
 #if defined(RSLM_REAL_FLOAT)
@@ -65,6 +72,15 @@ inline constexpr const char* kRealName =
 #  define RSLM_UNLIKELY(x) (x)
 #endif
 
+// Vectorization hint for SoA lane loops in batched kernels (no-op if unsupported).
+#if defined(__clang__)
+#  define RSLM_VECTORIZE _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#  define RSLM_VECTORIZE _Pragma("GCC ivdep")
+#else
+#  define RSLM_VECTORIZE
+#endif
+
 // Turn on extra expensive argument logging in hot helpers (off by default).
 // You can export RSLM_TRACE_HEAVY=1 at runtime; see numeric/rng for usage.
 inline bool trace_heavy_default() noexcept { return false; }
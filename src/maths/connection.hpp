@@ -4,10 +4,20 @@
  * ---------------------------
  * Christoffel symbols Γ^μ_{αβ} (Levi–Civita) from a metric field via
  * finite differences ∂_a g_{μν}.
+ * prepare_metric_batch builds many packs at once: all 9 stencil points go
+ * through the field's batch hook and g⁻¹ comes from sym4_inverse_batch.
  */
 
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
 #include "config.hpp"
+#include "types.hpp"
 #include "linalg.hpp"
+#include "linalg_batch.hpp"
+#include "parallel.hpp"
+#include "units.hpp"
 #include "quadform.hpp"
 #include "deriv.hpp"
 #include "trace.hpp"
@@ -20,21 +30,13 @@ using rslm::linalg::mat4;
 using rslm::linalg::sym4;
 using rslm::deriv::DMetric4;
 using rslm::field::IMetricField;
+using rslm::field::MetricFieldLike;
 
-struct Gamma {
-    // G[mu][a][b] = Γ^μ_{αβ}
-    real G[4][4][4]{};
-};
-
-struct MetricPack {
-    sym4 g;
-    mat4 g_inv;
-    DMetric4 dg; // ∂_a g
-    bool inv_ok{false};
-};
+// Gamma (Γ^μ_{αβ}) and MetricPack {g, g⁻¹, ∂g} are declared in types.hpp.
 
 // Invert g with robust fallback tolerance
-inline MetricPack prepare_metric(const IMetricField& F, const vec4& x) {
+template <MetricFieldLike Fd>
+inline MetricPack prepare_metric(const Fd& F, const vec4& x) {
     MetricPack P;
     P.g = F.g(x);
 
@@ -49,6 +51,56 @@ inline MetricPack prepare_metric(const IMetricField& F, const vec4& x) {
     return P;
 }
 
+/**
+ * out[k] = prepare_metric(F, x[k]) for k < n, in blocks of `block` lanes.
+ * g and ∂g are bitwise those of prepare_metric; g⁻¹ is the cofactor inverse
+ * (agrees to rounding), inv_ok its relative conditioning flag.
+ */
+template <MetricFieldLike Fd>
+inline void prepare_metric_batch(const Fd& F, const vec4* x, std::size_t n, MetricPack* out,
+                                 unsigned threads = 0, std::size_t block = 256)
+{
+    const real h = rslm::units::C().fd_h;
+    const real s = real(0.5) / h;
+    block = std::max<std::size_t>(1, block);
+    const std::size_t nblocks = (n + block - 1) / block;
+    rslm::par::parallel_for(nblocks, [&](std::size_t b, std::size_t e) {
+        std::vector<vec4> xs(9 * block);
+        std::vector<sym4> gs(9 * block);
+        rslm::linalg::Sym4Batch G, Gi;
+        rslm::linalg::Sym4InvReport R;
+        for (std::size_t bl=b; bl<e; ++bl) {
+            const std::size_t k0 = bl * block, m = std::min(block, n - k0);
+            // point layout: [0, m) centers, then (2a+1)·m + k for +h e_a, (2a+2)·m + k for -h e_a
+            for (std::size_t k=0;k<m;++k) {
+                xs[k] = x[k0 + k];
+                for (int a=0;a<4;++a) {
+                    vec4 xp = x[k0 + k], xm = x[k0 + k];
+                    xp.v[a] += h; xm.v[a] -= h;
+                    xs[(2*a+1)*m + k] = xp;
+                    xs[(2*a+2)*m + k] = xm;
+                }
+            }
+            rslm::deriv::g_points(F, xs.data(), gs.data(), 9 * m);
+            G.resize(m);
+            for (std::size_t k=0;k<m;++k) G.set(k, gs[k]);
+            rslm::linalg::sym4_inverse_batch(G, Gi, R, real(1e-14));
+            for (std::size_t k=0;k<m;++k) {
+                MetricPack& P = out[k0 + k];
+                P.g = gs[k];
+                P.g_inv = Gi.get(k);
+                P.inv_ok = R.ok[k] != 0;
+                for (int a=0;a<4;++a) {
+                    const sym4& gp = gs[(2*a+1)*m + k];
+                    const sym4& gm = gs[(2*a+2)*m + k];
+                    for (int r=0;r<4;++r)
+                        for (int c=0;c<4;++c) P.dg.dg[a].m[r][c] = (gp.m[r][c] - gm.m[r][c]) * s;
+                }
+            }
+        }
+    }, threads, 1);
+}
+
 inline Gamma christoffel(const MetricPack& M) {
     Gamma out{};
     // Γ^μ_{αβ} = 1/2 g^{μν} ( ∂_α g_{νβ} + ∂_β g_{να} - ∂_ν g_{αβ} )
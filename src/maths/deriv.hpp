@@ -6,7 +6,11 @@
  * We keep it explicit (no templates over tensor types) for clarity.
  */
 
+#include <cstddef>
+#include <type_traits>
+
 #include "config.hpp"
+#include "types.hpp"
 #include "linalg.hpp"
 #include "field.hpp"
 #include "units.hpp"
@@ -20,9 +24,12 @@ using rslm::linalg::mat4;
 using rslm::linalg::sym4;
 using rslm::field::IMetricField;
 using rslm::field::IPotential;
+using rslm::field::MetricFieldLike;
+using rslm::field::PotentialLike;
 
 // ∂_a g_{μν}(x) for a ∈ {0..3}. Returns a 4×4 matrix of partials (still symmetric).
-inline mat4 dmetric(const IMetricField& F, const vec4& x, int a, real h = rslm::units::C().fd_h) {
+template <MetricFieldLike Fd>
+inline mat4 dmetric(const Fd& F, const vec4& x, int a, real h = rslm::units::C().fd_h) {
     vec4 xp = x, xm = x;
     xp.v[a] += h; xm.v[a] -= h;
     sym4 gp = F.g(xp);
@@ -37,28 +44,124 @@ inline mat4 dmetric(const IMetricField& F, const vec4& x, int a, real h = rslm::
     return d;
 }
 
-// Full set of partials: dg[a] = ∂_a g
-struct DMetric4 {
-    mat4 dg[4];
-};
-
-inline DMetric4 dmetric4(const IMetricField& F, const vec4& x, real h = rslm::units::C().fd_h) {
+// Full set of partials: dg[a] = ∂_a g  (DMetric4, see types.hpp)
+template <MetricFieldLike Fd>
+inline DMetric4 dmetric4(const Fd& F, const vec4& x, real h = rslm::units::C().fd_h) {
     DMetric4 out;
     for (int a=0;a<4;++a) out.dg[a] = dmetric(F, x, a, h);
     return out;
 }
 
-// Potential gradient: (∂_0 V, ∂_1 V, ∂_2 V, ∂_3 V)
-inline vec4 gradV(const IPotential& P, const vec4& x, real h = rslm::units::C().fd_h) {
-    vec4 g;
+// Fd itself declares g_batch (not just inherits IMetricField's default loop).
+template <typename Fd>
+concept OwnBatchMetric = requires { &Fd::g_batch; } &&
+    std::is_same_v<decltype(&Fd::g_batch), void (Fd::*)(const vec4*, sym4*, std::size_t) const>;
+
+/**
+ * Evaluate g at n points as one batch. Open hierarchies (IMetricField&) go
+ * through the virtual g_batch hook; a concrete type uses its own g_batch if it
+ * declares one, otherwise a direct loop over g() that the compiler can inline.
+ */
+template <MetricFieldLike Fd>
+inline void g_points(const Fd& F, const vec4* xs, sym4* out, std::size_t n) {
+    constexpr bool open_virtual = std::is_base_of_v<IMetricField, Fd> && !std::is_final_v<Fd>;
+    if constexpr (open_virtual || OwnBatchMetric<Fd>) F.g_batch(xs, out, n);
+    else for (std::size_t k=0;k<n;++k) out[k] = F.g(xs[k]);
+}
+
+// Second partials: ddg[a][b] = ∂_a ∂_b g  (DDMetric4, see types.hpp)
+
+// Fd itself declares metric_jet (closed-form or batched derivatives).
+template <typename Fd>
+concept OwnJetMetric = requires { &Fd::metric_jet; } &&
+    std::is_same_v<decltype(&Fd::metric_jet),
+                   bool (Fd::*)(const vec4&, sym4&, DMetric4&, DDMetric4&, real) const>;
+
+// Points of the shared second-order stencil: x, x ± h e_a, and x ± h e_a ± h e_b (a<b)
+inline constexpr int kJetPoints = 1 + 8 + 24;
+
+/**
+ * g, ∂g and ∂∂g at x from one 33-point stencil evaluated as a single batch.
+ * ∂_a g is the same central difference as dmetric; ∂_a∂_a g = (g₊ - 2g + g₋)/h²,
+ * ∂_a∂_b g = (g₊₊ - g₊₋ - g₋₊ + g₋₋)/(4h²).
+ */
+template <MetricFieldLike Fd>
+inline void stencil_jet(const Fd& F, const vec4& x, sym4& g, DMetric4& dg, DDMetric4& ddg,
+                        real h = rslm::units::C().fd_h)
+{
+    vec4 xs[kJetPoints];
+    sym4 gs[kJetPoints];
+    xs[0] = x;
+    for (int a=0;a<4;++a) {
+        xs[1+2*a] = x; xs[1+2*a].v[a] += h;
+        xs[2+2*a] = x; xs[2+2*a].v[a] -= h;
+    }
+    int k = 9;
+    for (int a=0;a<4;++a)
+        for (int b=a+1;b<4;++b)
+            for (int sa=0;sa<2;++sa)
+                for (int sb=0;sb<2;++sb) {
+                    xs[k] = x;
+                    xs[k].v[a] += sa ? -h : h;
+                    xs[k].v[b] += sb ? -h : h;
+                    ++k;
+                }
+    g_points(F, xs, gs, kJetPoints);
+
+    g = gs[0];
+    const real s1 = real(0.5) / h, s2 = real(1) / (h*h), s4 = real(0.25) / (h*h);
     for (int a=0;a<4;++a) {
-        vec4 xp = x, xm = x;
-        xp.v[a] += h; xm.v[a] -= h;
-        real vp = P.V(xp);
-        real vm = P.V(xm);
-        g.v[a] = (vp - vm) * (real(0.5)/h);
+        const sym4& gp = gs[1+2*a];
+        const sym4& gm = gs[2+2*a];
+        for (int r=0;r<4;++r)
+            for (int c=0;c<4;++c) {
+                dg.dg[a].m[r][c] = (gp.m[r][c] - gm.m[r][c]) * s1;
+                ddg.ddg[a][a].m[r][c] = (gp.m[r][c] - real(2)*g.m[r][c] + gm.m[r][c]) * s2;
+            }
+    }
+    k = 9;
+    for (int a=0;a<4;++a)
+        for (int b=a+1;b<4;++b, k+=4)
+            for (int r=0;r<4;++r)
+                for (int c=0;c<4;++c) {
+                    real v = (gs[k].m[r][c] - gs[k+1].m[r][c] - gs[k+2].m[r][c] + gs[k+3].m[r][c]) * s4;
+                    ddg.ddg[a][b].m[r][c] = v;
+                    ddg.ddg[b][a].m[r][c] = v;
+                }
+}
+
+/**
+ * g, ∂g and ∂∂g at x. Open hierarchies go through the virtual metric_jet hook
+ * and a concrete type uses its own metric_jet if it declares one (closed-form
+ * lattice jets, forward-mode MLP jets); stencil_jet otherwise, or when the
+ * hook declines.
+ */
+template <MetricFieldLike Fd>
+inline void metric_jet(const Fd& F, const vec4& x, sym4& g, DMetric4& dg, DDMetric4& ddg,
+                       real h = rslm::units::C().fd_h)
+{
+    constexpr bool open_virtual = std::is_base_of_v<IMetricField, Fd> && !std::is_final_v<Fd>;
+    if constexpr (open_virtual || OwnJetMetric<Fd>) {
+        if (F.metric_jet(x, g, dg, ddg, h)) return;
+    }
+    stencil_jet(F, x, g, dg, ddg, h);
+}
+
+// Pt itself declares grad(x, h) (a closed-form gradient).
+template <typename Pt>
+concept OwnGradPotential = requires { &Pt::grad; } &&
+    std::is_same_v<decltype(&Pt::grad), vec4 (Pt::*)(const vec4&, real) const>;
+
+// Potential gradient: (∂_0 V, ∂_1 V, ∂_2 V, ∂_3 V). Uses the potential's grad()
+// hook for open hierarchies or types that declare one; central differences otherwise.
+template <PotentialLike Pt>
+inline vec4 gradV(const Pt& P, const vec4& x, real h = rslm::units::C().fd_h) {
+    constexpr bool open_virtual = std::is_base_of_v<IPotential, Pt> && !std::is_final_v<Pt>;
+    if constexpr (open_virtual || OwnGradPotential<Pt>) {
+        return P.grad(x, h);
+    } else {
+        return rslm::field::central_grad(P, x, h);
     }
-    return g;
 }
 
 } // namespace rslm::deriv
@@ -0,0 +1,87 @@
+#pragma once
+/**
+ * RSLM Maths — diagnostics/accum.hpp
+ * ----------------------------------
+ * Streaming statistics for audits and samplers:
+ *  - Accumulator : count / mean / variance (Welford) + min/max, mergeable
+ *  - Histogram   : fixed-range bins with under/overflow counters, mergeable
+ *
+ * Both are plain value types so per-thread partials can be merged at the end.
+ */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include "config.hpp"
+
+namespace rslm::diag {
+
+using rslm::cfg::real;
+
+struct Accumulator {
+    std::uint64_t n{0};
+    long double mean{0};
+    long double m2{0};          // Σ (x - mean)^2
+    real vmin{ std::numeric_limits<real>::infinity()};
+    real vmax{-std::numeric_limits<real>::infinity()};
+
+    inline void push(real x) {
+        ++n;
+        long double d = (long double)x - mean;
+        mean += d / (long double)n;
+        m2   += d * ((long double)x - mean);
+        if (x < vmin) vmin = x;
+        if (x > vmax) vmax = x;
+    }
+
+    // Chan et al. parallel combination
+    inline void merge(const Accumulator& o) {
+        if (o.n == 0) return;
+        if (n == 0) { *this = o; return; }
+        long double na = (long double)n, nb = (long double)o.n, nt = na + nb;
+        long double d  = o.mean - mean;
+        mean += d * (nb / nt);
+        m2   += o.m2 + d*d * (na*nb / nt);
+        n    += o.n;
+        vmin = std::min(vmin, o.vmin);
+        vmax = std::max(vmax, o.vmax);
+    }
+
+    inline real variance() const { return n > 1 ? real(m2 / (long double)(n - 1)) : real(0); }
+    inline real stddev()   const { return std::sqrt(variance()); }
+    inline real avg()      const { return real(mean); }
+};
+
+struct Histogram {
+    real lo{0}, hi{1};
+    std::vector<std::uint64_t> bins;
+    std::uint64_t under{0}, over{0};
+
+    Histogram() = default;
+    Histogram(real lo_, real hi_, std::size_t nbins) : lo(lo_), hi(hi_), bins(nbins, 0) {}
+
+    inline void push(real x) {
+        if (!(x >= lo)) { ++under; return; }   // also catches NaN
+        if (x >= hi)    { ++over;  return; }
+        std::size_t k = std::size_t((x - lo) / (hi - lo) * real(bins.size()));
+        if (k >= bins.size()) k = bins.size() - 1;
+        ++bins[k];
+    }
+
+    // Requires identical binning; silently ignores mismatched histograms.
+    inline void merge(const Histogram& o) {
+        if (o.bins.size() != bins.size() || o.lo != lo || o.hi != hi) return;
+        for (std::size_t k=0;k<bins.size();++k) bins[k] += o.bins[k];
+        under += o.under; over += o.over;
+    }
+
+    inline real bin_center(std::size_t k) const {
+        return lo + (real(k) + real(0.5)) * (hi - lo) / real(bins.size());
+    }
+};
+
+} // namespace rslm::diag
@@ -0,0 +1,425 @@
+#pragma once
+/**
+ * RSLM Maths — diagnostics/arrow_ipc.hpp
+ * --------------------------------------
+ * Dependency-free columnar export in the Arrow IPC file format (".arrow",
+ * a.k.a. Feather v2), readable by pyarrow / polars / DuckDB without parsing.
+ *  - ArrowWriter : schema of fixed-width numeric columns (f32/f64/i32/i64,
+ *                  non-nullable); write_batch() appends record batches as
+ *                  they come (streamable), close() writes the footer
+ *  - save_arrow(Grid2D | channels) : x, y, value / one column per channel
+ *  - save_path_arrow()             : traj_id, tau, t, x, y, z [, u0..u3]
+ *  - save_events_arrow()           : t, x, y, z, u0..u3, E, m
+ *
+ * Layout: "ARROW1\0\0" | Schema msg | RecordBatch msgs | EOS | Footer | len | "ARROW1".
+ * Message metadata is a hand-built flatbuffer (Schema.fbs / Message.fbs /
+ * File.fbs, metadata V5); body buffers are 64-byte aligned, so the data can
+ * be used in place from an mmap. With stream_format=true the file is a plain
+ * Arrow IPC stream (no magic, no footer). Little-endian hosts only.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "types.hpp"
+#include "grid.hpp"
+#include "export.hpp"
+#include "trace.hpp"
+
+namespace rslm::diag {
+
+// ---- Minimal flatbuffer builder (back-to-front, as flatc does) ----------------------
+namespace fb {
+
+class Builder {
+public:
+    // Positions are measured from the end of the buffer (stable while we prepend).
+    std::size_t size() const { return buf_.size(); }
+
+    template <typename T>
+    std::size_t scalar(T v) { pre_align(sizeof(T), sizeof(T)); push(v); return size(); }
+
+    // uoffset to an object finished at `target` (its position from the end)
+    std::size_t uoffset(std::size_t target) {
+        pre_align(4, 4);
+        push<std::uint32_t>(std::uint32_t(size() + 4 - target));
+        return size();
+    }
+
+    std::size_t string(std::string_view s) {
+        pre_align(s.size() + 1, 4);
+        buf_.insert(buf_.begin(), 1, 0);
+        buf_.insert(buf_.begin(), s.begin(), s.end());
+        push<std::uint32_t>(std::uint32_t(s.size()));
+        return size();
+    }
+
+    // Vector of structs / scalars given as raw little-endian bytes
+    std::size_t vector_raw(const void* data, std::size_t n, std::size_t elem_size, std::size_t elem_align) {
+        pre_align(n * elem_size, std::max<std::size_t>(4, elem_align));
+        auto* p = static_cast<const unsigned char*>(data);
+        buf_.insert(buf_.begin(), p, p + n * elem_size);
+        push<std::uint32_t>(std::uint32_t(n));
+        max_align_ = std::max(max_align_, elem_align);
+        return size();
+    }
+
+    std::size_t vector_offsets(const std::vector<std::size_t>& targets) {
+        pre_align(4 * targets.size(), 4);
+        for (std::size_t k=targets.size(); k-- > 0;) push<std::uint32_t>(std::uint32_t(size() + 4 - targets[k]));
+        push<std::uint32_t>(std::uint32_t(targets.size()));
+        return size();
+    }
+
+    void start_table() { fields_.clear(); table_start_ = size(); }
+
+    template <typename T>
+    void add(std::uint16_t id, T v) { fields_.push_back({ id, scalar(v) }); }
+    void add_offset(std::uint16_t id, std::size_t target) { fields_.push_back({ id, uoffset(target) }); }
+
+    std::size_t end_table() {
+        pre_align(4, 4);
+        push<std::int32_t>(0);                                  // soffset to vtable, patched below
+        const std::size_t table_end = size();
+
+        std::uint16_t nslots = 0;
+        for (auto& f : fields_) nslots = std::max<std::uint16_t>(nslots, std::uint16_t(f.id + 1));
+        std::vector<std::uint16_t> off(nslots, 0);
+        for (auto& f : fields_) off[f.id] = std::uint16_t(table_end - f.end);
+
+        for (std::size_t k=nslots; k-- > 0;) push<std::uint16_t>(off[k]);
+        push<std::uint16_t>(std::uint16_t(table_end - table_start_));
+        push<std::uint16_t>(std::uint16_t(4 + 2 * nslots));
+        const std::size_t vt_end = size();
+
+        std::int32_t so = std::int32_t(vt_end - table_end);     // vtable = table - soffset
+        std::memcpy(buf_.data() + (size() - table_end), &so, 4);
+        return table_end;
+    }
+
+    // Root uoffset in front; total size padded to 8 bytes.
+    std::vector<unsigned char> finish(std::size_t root) {
+        pre_align(4, std::max<std::size_t>(8, max_align_));
+        uoffset(root);
+        return buf_;
+    }
+
+private:
+    struct Slot { std::uint16_t id; std::size_t end; };
+
+    template <typename T>
+    void push(T v) {
+        unsigned char b[sizeof(T)];
+        std::memcpy(b, &v, sizeof(T));
+        buf_.insert(buf_.begin(), b, b + sizeof(T));
+        max_align_ = std::max(max_align_, sizeof(T));
+    }
+    void pre_align(std::size_t len, std::size_t a) {
+        std::size_t pad = (a - (buf_.size() + len) % a) % a;
+        if (pad) buf_.insert(buf_.begin(), pad, 0);
+    }
+
+    std::vector<unsigned char> buf_;
+    std::vector<Slot> fields_;
+    std::size_t table_start_{0};
+    std::size_t max_align_{1};
+};
+
+} // namespace fb
+
+// ---- Arrow IPC writer ---------------------------------------------------------------
+
+enum class ArrowType : std::uint8_t { f32, f64, i32, i64 };
+
+inline constexpr ArrowType kArrowReal = sizeof(rslm::cfg::real) == 4 ? ArrowType::f32 : ArrowType::f64;
+
+inline std::size_t arrow_width(ArrowType t) {
+    return (t == ArrowType::f32 || t == ArrowType::i32) ? 4 : 8;
+}
+
+struct ArrowField {
+    std::string name;
+    ArrowType type;
+};
+
+class ArrowWriter {
+public:
+    ArrowWriter() = default;
+    ~ArrowWriter() { close(); }
+    ArrowWriter(const ArrowWriter&) = delete;
+    ArrowWriter& operator=(const ArrowWriter&) = delete;
+
+    bool open(const std::string& path, std::vector<ArrowField> schema, bool stream_format = false) {
+        close();
+        ensure_dir(std::filesystem::path(path).parent_path());
+        f_ = std::fopen(path.c_str(), "wb");
+        if (!f_) return false;
+        schema_ = std::move(schema);
+        stream_ = stream_format;
+        pos_ = 0; batches_.clear(); ok_ = true; path_ = path;
+        if (!stream_) put("ARROW1\0\0", 8);
+        fb::Builder b;
+        std::size_t s = build_schema(b);
+        write_message(b, /*Schema*/1, s, 0);
+        return ok_;
+    }
+
+    // cols[c] points at nrows values of schema[c].type
+    bool write_batch(std::size_t nrows, const std::vector<const void*>& cols) {
+        if (!f_ || cols.size() != schema_.size()) return false;
+
+        // body: per column a (empty) validity buffer and the data buffer
+        std::vector<std::int64_t> nodes, bufs;
+        std::int64_t body = 0;
+        for (const auto& fld : schema_) {
+            std::int64_t len = std::int64_t(nrows * arrow_width(fld.type));
+            nodes.push_back(std::int64_t(nrows)); nodes.push_back(0);
+            bufs.push_back(body); bufs.push_back(0);
+            bufs.push_back(body); bufs.push_back(len);
+            body += pad64(len);
+        }
+
+        fb::Builder b;
+        std::size_t vb = b.vector_raw(bufs.data(), bufs.size() / 2, 16, 8);
+        std::size_t vn = b.vector_raw(nodes.data(), nodes.size() / 2, 16, 8);
+        b.start_table();
+        b.add<std::int64_t>(0, std::int64_t(nrows));
+        b.add_offset(1, vn);
+        b.add_offset(2, vb);
+        std::size_t rb = b.end_table();
+
+        Block blk;
+        blk.offset = std::int64_t(pos_);
+        blk.meta_len = write_message(b, /*RecordBatch*/3, rb, body);
+        blk.body_len = body;
+
+        static const unsigned char zeros[64] = {};
+        for (std::size_t c=0;c<cols.size();++c) {
+            std::size_t len = nrows * arrow_width(schema_[c].type);
+            if (len) put(cols[c], len);
+            put(zeros, std::size_t(pad64(std::int64_t(len))) - len);
+        }
+        batches_.push_back(blk);
+        return ok_;
+    }
+
+    // EOS marker and (file format) footer. Returns false if any write failed.
+    bool close() {
+        if (!f_) return ok_;
+        const std::uint32_t eos[2] = { 0xFFFFFFFFu, 0u };
+        put(eos, 8);
+        if (!stream_) {
+            fb::Builder b;
+            std::size_t rbs  = b.vector_raw(batches_.data(), batches_.size(), sizeof(Block), 8);
+            std::size_t dict = b.vector_raw(nullptr, 0, sizeof(Block), 8);
+            std::size_t s    = build_schema(b);
+            b.start_table();
+            b.add<std::int16_t>(0, kMetadataV5);
+            b.add_offset(1, s);
+            b.add_offset(2, dict);
+            b.add_offset(3, rbs);
+            auto footer = b.finish(b.end_table());
+            put(footer.data(), footer.size());
+            std::int32_t n = std::int32_t(footer.size());
+            put(&n, 4);
+            put("ARROW1", 6);
+        }
+        ok_ = (std::fclose(f_) == 0) && ok_;
+        f_ = nullptr;
+        TRACE_INFO("save_arrow", path_);
+        return ok_;
+    }
+
+private:
+    struct Block {                       // File.fbs struct Block (24 bytes)
+        std::int64_t offset{0};
+        std::int32_t meta_len{0};
+        std::int32_t pad_{0};
+        std::int64_t body_len{0};
+    };
+    static_assert(sizeof(Block) == 24, "Arrow Block layout");
+
+    static constexpr std::int16_t kMetadataV5 = 4;
+
+    static std::int64_t pad64(std::int64_t n) { return (n + 63) / 64 * 64; }
+
+    void put(const void* p, std::size_t n) {
+        if (n && std::fwrite(p, 1, n, f_) != n) ok_ = false;
+        pos_ += n;
+    }
+
+    std::size_t build_schema(fb::Builder& b) const {
+        std::vector<std::size_t> fields;
+        for (const auto& fld : schema_) {
+            std::size_t name = b.string(fld.name);
+            std::uint8_t type_type;
+            b.start_table();
+            if (fld.type == ArrowType::f32 || fld.type == ArrowType::f64) {
+                b.add<std::int16_t>(0, fld.type == ArrowType::f32 ? 1 : 2);       // FloatingPoint.precision
+                type_type = 3;
+            } else {
+                b.add<std::int32_t>(0, fld.type == ArrowType::i32 ? 32 : 64);     // Int.bitWidth
+                b.add<std::uint8_t>(1, 1);                                        // Int.is_signed
+                type_type = 2;
+            }
+            std::size_t type = b.end_table();
+            std::size_t children = b.vector_offsets({});
+            b.start_table();
+            b.add_offset(0, name);
+            b.add<std::uint8_t>(1, 0);            // nullable = false
+            b.add<std::uint8_t>(2, type_type);
+            b.add_offset(3, type);
+            b.add_offset(5, children);
+            fields.push_back(b.end_table());
+        }
+        std::size_t vf = b.vector_offsets(fields);
+        b.start_table();
+        b.add<std::int16_t>(0, 0);                // endianness = Little
+        b.add_offset(1, vf);
+        return b.end_table();
+    }
+
+    // Encapsulated message: 0xFFFFFFFF, int32 metadata length, Message flatbuffer (8-aligned).
+    std::int32_t write_message(fb::Builder& b, std::uint8_t header_type, std::size_t header, std::int64_t body) {
+        b.start_table();
+        b.add<std::int16_t>(0, kMetadataV5);
+        b.add<std::uint8_t>(1, header_type);
+        b.add_offset(2, header);
+        b.add<std::int64_t>(3, body);
+        auto meta = b.finish(b.end_table());
+        meta.resize((meta.size() + 7) / 8 * 8, 0);
+        const std::uint32_t cont = 0xFFFFFFFFu;
+        std::int32_t len = std::int32_t(meta.size());
+        put(&cont, 4);
+        put(&len, 4);
+        put(meta.data(), meta.size());
+        return len + 8;
+    }
+
+    std::FILE* f_{nullptr};
+    std::vector<ArrowField> schema_;
+    std::vector<Block> batches_;
+    std::size_t pos_{0};
+    bool stream_{false};
+    bool ok_{true};
+    std::string path_;
+};
+
+// ---- Convenience exports ------------------------------------------------------------
+
+inline constexpr std::size_t kArrowBatchRows = std::size_t(1) << 16;
+
+/** Grid channels sharing one geometry: columns x, y, then one per channel (row-major cells). */
+inline bool save_arrow(const std::vector<const Grid2D*>& channels, const std::vector<std::string>& names,
+                       const std::string& path, bool stream_format = false)
+{
+    if (channels.empty() || names.size() != channels.size()) return false;
+    const Grid2D& G0 = *channels[0];
+    for (auto* C : channels) if (C->nx != G0.nx || C->ny != G0.ny) return false;
+
+    std::vector<ArrowField> schema{ {"x", kArrowReal}, {"y", kArrowReal} };
+    for (auto& n : names) schema.push_back({ n, kArrowReal });
+    ArrowWriter W;
+    if (!W.open(path, std::move(schema), stream_format)) return false;
+
+    const std::size_t n = G0.nx * G0.ny;
+    std::vector<real> xs, ys;
+    for (std::size_t b=0;b<n;b+=kArrowBatchRows) {
+        std::size_t e = std::min(n, b + kArrowBatchRows);
+        xs.resize(e - b); ys.resize(e - b);
+        for (std::size_t k=b;k<e;++k) {
+            xs[k-b] = G0.x0 + real(k % G0.ny)*G0.dx;
+            ys[k-b] = G0.y0 + real(k / G0.ny)*G0.dy;
+        }
+        std::vector<const void*> cols{ xs.data(), ys.data() };
+        for (auto* C : channels) cols.push_back(C->val.data() + b);
+        W.write_batch(e - b, cols);
+    }
+    return W.close();
+}
+
+inline bool save_arrow(const Grid2D& G, const std::string& path, bool stream_format = false) {
+    return save_arrow({ &G }, { "value" }, path, stream_format);
+}
+
+/**
+ * Trajectories: traj_id, tau, t, x, y, z and, if u is given, u0..u3.
+ * paths[k] (and u[k], tau[k] when given) belong to trajectory k; tau
+ * defaults to the step index.
+ */
+inline bool save_path_arrow(const std::vector<std::vector<vec4>>& paths, const std::string& path,
+                            const std::vector<std::vector<vec4>>* u = nullptr,
+                            const std::vector<std::vector<real>>* tau = nullptr,
+                            bool stream_format = false)
+{
+    if (u && u->size() != paths.size()) return false;
+    if (tau && tau->size() != paths.size()) return false;
+    std::vector<ArrowField> schema{ {"traj_id", ArrowType::i64}, {"tau", kArrowReal},
+                                    {"t", kArrowReal}, {"x", kArrowReal}, {"y", kArrowReal}, {"z", kArrowReal} };
+    if (u) for (const char* nm : { "u0", "u1", "u2", "u3" }) schema.push_back({ nm, kArrowReal });
+    ArrowWriter W;
+    if (!W.open(path, std::move(schema), stream_format)) return false;
+
+    // one record batch per trajectory (split if longer than kArrowBatchRows)
+    std::vector<std::int64_t> id;
+    std::vector<real> ta, c[8];
+    for (std::size_t k=0;k<paths.size();++k) {
+        const auto& P = paths[k];
+        if (u && (*u)[k].size() != P.size()) return false;
+        if (tau && (*tau)[k].size() != P.size()) return false;
+        for (std::size_t b=0;b<P.size();b+=kArrowBatchRows) {
+            std::size_t e = std::min(P.size(), b + kArrowBatchRows), m = e - b;
+            id.assign(m, std::int64_t(k));
+            ta.resize(m);
+            for (auto& v : c) v.resize(m);
+            for (std::size_t i=0;i<m;++i) {
+                ta[i] = tau ? (*tau)[k][b+i] : real(b+i);
+                for (int a=0;a<4;++a) c[a][i] = P[b+i].v[a];
+                if (u) for (int a=0;a<4;++a) c[4+a][i] = (*u)[k][b+i].v[a];
+            }
+            std::vector<const void*> cols{ id.data(), ta.data(), c[0].data(), c[1].data(), c[2].data(), c[3].data() };
+            if (u) for (int a=4;a<8;++a) cols.push_back(c[a].data());
+            W.write_batch(m, cols);
+        }
+    }
+    return W.close();
+}
+
+inline bool save_path_arrow(const std::vector<vec4>& path, const std::string& file) {
+    return save_path_arrow(std::vector<std::vector<vec4>>{ path }, file);
+}
+
+/** Event set: t, x, y, z, u0..u3, E, m. */
+inline bool save_events_arrow(const std::vector<rslm::phys::Event>& evs, const std::string& path,
+                              bool stream_format = false)
+{
+    std::vector<ArrowField> schema;
+    for (const char* nm : { "t", "x", "y", "z", "u0", "u1", "u2", "u3", "E", "m" }) schema.push_back({ nm, kArrowReal });
+    ArrowWriter W;
+    if (!W.open(path, std::move(schema), stream_format)) return false;
+    std::vector<real> c[10];
+    for (std::size_t b=0;b<evs.size();b+=kArrowBatchRows) {
+        std::size_t e = std::min(evs.size(), b + kArrowBatchRows), m = e - b;
+        for (auto& v : c) v.resize(m);
+        for (std::size_t i=0;i<m;++i) {
+            const auto& ev = evs[b+i];
+            for (int a=0;a<4;++a) { c[a][i] = ev.x.v[a]; c[4+a][i] = ev.u.v[a]; }
+            c[8][i] = ev.E; c[9][i] = ev.m;
+        }
+        std::vector<const void*> cols;
+        for (auto& v : c) cols.push_back(v.data());
+        W.write_batch(m, cols);
+    }
+    return W.close();
+}
+
+} // namespace rslm::diag
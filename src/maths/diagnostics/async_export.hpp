@@ -0,0 +1,244 @@
+#pragma once
+/**
+ * RSLM Maths — diagnostics/async_export.hpp
+ * -----------------------------------------
+ * Asynchronous export of diagnostics files on dedicated I/O threads.
+ *  - ExportQueue : owns the I/O thread(s); save_csv / save_ascii / save_obj_surface /
+ *                  save_ppm / save_path_csv take a snapshot of the data and return
+ *                  immediately with an AsyncResult
+ *  - AsyncResult : C++20 awaitable (co_await → bool) that also works without
+ *                  coroutines (get() blocks, ready() polls); it is also a coroutine
+ *                  return type, so a checkpoint can be written as a coroutine
+ *
+ * In-flight bytes (snapshots not yet written) are capped: a submit that would
+ * exceed the cap waits until earlier jobs finish (one oversized job is always
+ * admitted; submits from an I/O thread never wait). Awaiting coroutines resume
+ * on the I/O thread, so keep the code after co_await light or hand the rest
+ * back to a compute thread.
+ *
+ * Writes go through the blocking exporters (export.hpp, ppm.hpp, overlay.hpp)
+ * on the I/O thread; files are byte-identical to the synchronous path.
+ */
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "grid.hpp"
+#include "export.hpp"
+#include "ppm.hpp"
+#include "palette.hpp"
+#include "overlay.hpp"
+#include "trace.hpp"
+
+namespace rslm::diag {
+
+using rslm::linalg::vec4;
+
+class AsyncResult {
+    struct State {
+        std::mutex mtx;
+        std::condition_variable cv;
+        bool done{false};
+        bool ok{false};
+        std::coroutine_handle<> waiter{};
+    };
+
+public:
+    // ---- coroutine return type: bool-returning coroutines (eager start) --------
+    struct promise_type {
+        std::shared_ptr<State> st = std::make_shared<State>();
+        AsyncResult get_return_object() { return AsyncResult(st); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_value(bool ok) { AsyncResult(st).complete(ok); }
+        void unhandled_exception() { AsyncResult(st).complete(false); }
+    };
+
+    AsyncResult() : st_(std::make_shared<State>()) {}
+    explicit AsyncResult(std::shared_ptr<State> s) : st_(std::move(s)) {}
+
+    // Mark finished and resume a suspended awaiter (called by the I/O thread).
+    void complete(bool ok) const {
+        std::coroutine_handle<> h;
+        {
+            std::scoped_lock lk(st_->mtx);
+            st_->ok = ok;
+            st_->done = true;
+            h = st_->waiter;
+            st_->waiter = {};
+        }
+        st_->cv.notify_all();
+        if (h) h.resume();
+    }
+
+    bool ready() const { std::scoped_lock lk(st_->mtx); return st_->done; }
+
+    bool get() const {
+        std::unique_lock lk(st_->mtx);
+        st_->cv.wait(lk, [&] { return st_->done; });
+        return st_->ok;
+    }
+
+    // ---- awaitable ------------------------------------------------------------
+    bool await_ready() const { return ready(); }
+    bool await_suspend(std::coroutine_handle<> h) const {
+        std::scoped_lock lk(st_->mtx);
+        if (st_->done) return false;            // finished meanwhile: continue inline
+        st_->waiter = h;
+        return true;
+    }
+    bool await_resume() const { std::scoped_lock lk(st_->mtx); return st_->ok; }
+
+private:
+    std::shared_ptr<State> st_;
+};
+
+class ExportQueue {
+public:
+    explicit ExportQueue(std::size_t max_inflight_bytes = std::size_t(256) << 20, unsigned io_threads = 1)
+        : cap_(max_inflight_bytes)
+    {
+        if (io_threads == 0) io_threads = 1;
+        for (unsigned t=0;t<io_threads;++t) pool_.emplace_back([this] { run(); });
+    }
+
+    ~ExportQueue() {
+        {
+            std::scoped_lock lk(mtx_);
+            stop_ = true;
+        }
+        cv_work_.notify_all();
+        for (auto& th : pool_) th.join();
+    }
+
+    ExportQueue(const ExportQueue&) = delete;
+    ExportQueue& operator=(const ExportQueue&) = delete;
+
+    // ---- Exporters (arguments are snapshotted; pass rvalues to avoid the copy) ----
+
+    AsyncResult save_csv(Grid2D G, std::string path) {
+        std::size_t b = bytes_of(G);
+        return submit(b, [G = std::move(G), path = std::move(path)] { return rslm::diag::save_csv(G, path); });
+    }
+
+    AsyncResult save_ascii(Grid2D G, std::string path) {
+        std::size_t b = bytes_of(G);
+        return submit(b, [G = std::move(G), path = std::move(path)] { return rslm::diag::save_ascii(G, path); });
+    }
+
+    AsyncResult save_obj_surface(Grid2D G, std::string path, double scale = 1.0) {
+        std::size_t b = bytes_of(G);
+        return submit(b, [G = std::move(G), path = std::move(path), scale] {
+            return rslm::diag::save_obj_surface(G, path, scale);
+        });
+    }
+
+    template <typename Palette>
+    AsyncResult save_ppm(Grid2D G, std::string path, double vmin = NAN, double vmax = NAN,
+                         std::vector<std::uint8_t> overlay = {}) {
+        std::size_t b = bytes_of(G) + overlay.size();
+        return submit(b, [G = std::move(G), path = std::move(path), vmin, vmax, overlay = std::move(overlay)] {
+            return rslm::diag::save_ppm<Palette>(G, path, vmin, vmax, overlay);
+        });
+    }
+
+    AsyncResult save_path_csv(std::vector<vec4> path, std::string file) {
+        std::size_t b = path.size() * sizeof(vec4);
+        return submit(b, [path = std::move(path), file = std::move(file)] {
+            return rslm::diag::save_path_csv(path, file);
+        });
+    }
+
+    // Generic job: fn() -> bool runs on an I/O thread; `bytes` counts toward the cap.
+    AsyncResult submit(std::size_t bytes, std::function<bool()> fn) {
+        AsyncResult r;
+        {
+            std::unique_lock lk(mtx_);
+            // never block an I/O thread (a resumed coroutine submitting again): it would stall the drain
+            if (!on_io_thread())
+                cv_space_.wait(lk, [&] { return inflight_ == 0 || inflight_ + bytes <= cap_; });
+            inflight_ += bytes;
+            jobs_.push_back(Job{ bytes, std::move(fn), r });
+        }
+        cv_work_.notify_one();
+        return r;
+    }
+
+    // Block until every submitted job has been written and its AsyncResult completed
+    // (queue empty and no job in flight). Called from an I/O thread (a resumed
+    // coroutine), the job it is resuming from does not count.
+    void flush() {
+        std::unique_lock lk(mtx_);
+        const std::size_t self = on_io_thread() ? 1 : 0;
+        cv_space_.wait(lk, [&] { return jobs_.empty() && running_ <= self; });
+    }
+
+    std::size_t inflight_bytes() const { std::scoped_lock lk(mtx_); return inflight_; }
+    std::size_t max_inflight_bytes() const { return cap_; }
+
+private:
+    struct Job {
+        std::size_t bytes;
+        std::function<bool()> fn;
+        AsyncResult result;
+    };
+
+    bool on_io_thread() const {
+        for (const auto& th : pool_) if (th.get_id() == std::this_thread::get_id()) return true;
+        return false;
+    }
+
+    static std::size_t bytes_of(const Grid2D& G) { return G.val.size() * sizeof(rslm::cfg::real); }
+
+    void run() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock lk(mtx_);
+                cv_work_.wait(lk, [&] { return stop_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;      // stop_ and drained
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+                ++running_;
+            }
+            bool ok = false;
+            try { ok = job.fn(); } catch (...) { ok = false; }
+            if (!ok) TRACE_WARN("async_export_failed", job.bytes);
+            job.fn = nullptr;                   // release the snapshot before accounting
+            {
+                std::scoped_lock lk(mtx_);
+                inflight_ -= job.bytes;
+            }
+            cv_space_.notify_all();
+            job.result.complete(ok);
+            {
+                std::scoped_lock lk(mtx_);
+                --running_;                     // after complete(): flush() covers the awaiter too
+            }
+            cv_space_.notify_all();
+        }
+    }
+
+    const std::size_t cap_;
+    mutable std::mutex mtx_;
+    std::condition_variable cv_work_, cv_space_;
+    std::deque<Job> jobs_;
+    std::size_t inflight_{0};
+    std::size_t running_{0};                    // jobs popped but not yet completed
+    bool stop_{false};
+    std::vector<std::thread> pool_;
+};
+
+} // namespace rslm::diag
@@ -0,0 +1,308 @@
+#pragma once
+/**
+ * RSLM Maths — diagnostics/diag_graph.hpp
+ * ---------------------------------------
+ * Lazy, demand-driven diagnostic graph with memoized intermediates.
+ *  - DiagGraph : nodes hold a value computed from their dependencies; request()
+ *                evaluates only what the requested outputs need, once, and runs
+ *                independent nodes of the same depth in parallel
+ *  - add_curvature_nodes() : the checkpoint stack over one XY slice
+ *        packs (g, g⁻¹, ∂g) → Γ → ||Γ||
+ *        Γ → curvature (∂Γ by central differences + assembly: Ricci,
+ *            ||Riemann||) → ||Riemann||
+ *        packs + curvature → R → G_{μν} ;  G_{μν} + T_{μν} → ||G − κT||
+ *  - add_export_ppm/obj/csv() : exporter nodes on top of any grid node
+ *
+ * Asking for the R heatmap and the residual OBJ shares a single Riemann pass
+ * per cell, and that pass reuses the memoized centre Γ (riemann_at would
+ * rebuild it); a new diagnostic only pays for its own node. Per-cell results
+ * match sample_xy(curv_scalar / curv_riemann_frob) and residual_norm exactly.
+ *
+ * Nodes capture the field, events and parameters by reference: they must
+ * outlive the graph. Node functions may only get<>() their declared deps.
+ */
+
+#include <any>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "connection.hpp"
+#include "curvature.hpp"
+#include "field.hpp"
+#include "parallel.hpp"
+#include "stress_energy.hpp"
+#include "einstein_fit.hpp"
+#include "grid.hpp"
+#include "export.hpp"
+#include "ppm.hpp"
+#include "palette.hpp"
+#include "trace.hpp"
+
+namespace rslm::diag {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+using rslm::field::IMetricField;
+
+class DiagGraph {
+public:
+    using NodeId = std::size_t;
+    static constexpr NodeId npos = NodeId(-1);
+
+    explicit DiagGraph(unsigned threads = 0) : threads_(threads ? threads : rslm::par::hardware_threads()) {}
+
+    /**
+     * Add a node computing fn(threads) -> T from `deps` (ids of earlier nodes).
+     * `threads` is this node's share of the pool while its level runs.
+     */
+    template <typename Fn>
+    NodeId add(std::string name, std::vector<NodeId> deps, Fn fn) {
+        Node n;
+        n.name = std::move(name);
+        n.deps = std::move(deps);
+        n.eval = [f = std::move(fn)](unsigned t) { return std::any(f(t)); };
+        nodes_.push_back(std::move(n));
+        return nodes_.size() - 1;
+    }
+
+    // Evaluate every output (and the missing part of its upstream), level by level.
+    void request(const std::vector<NodeId>& outs) {
+        std::vector<int> level(nodes_.size(), -1);
+        std::vector<NodeId> stack(outs.begin(), outs.end());
+        std::vector<char> need(nodes_.size(), 0);
+        while (!stack.empty()) {
+            NodeId id = stack.back(); stack.pop_back();
+            if (need[id] || nodes_[id].done) continue;
+            need[id] = 1;
+            for (NodeId d : nodes_[id].deps) stack.push_back(d);
+        }
+        // deps always have smaller ids, so one ascending pass yields depths
+        int depth = -1;
+        for (NodeId id=0; id<nodes_.size(); ++id) {
+            if (!need[id]) continue;
+            int l = 0;
+            for (NodeId d : nodes_[id].deps) if (need[d]) l = std::max(l, level[d] + 1);
+            level[id] = l;
+            depth = std::max(depth, l);
+        }
+        for (int l=0; l<=depth; ++l) {
+            std::vector<NodeId> wave;
+            for (NodeId id=0; id<nodes_.size(); ++id) if (level[id] == l) wave.push_back(id);
+            unsigned per = std::max(1u, threads_ / unsigned(wave.size()));
+            rslm::par::parallel_chunks(wave.size(), wave.size(), [&](std::size_t c, std::size_t, std::size_t) {
+                Node& n = nodes_[wave[c]];
+                n.value = n.eval(per);
+                n.done = true;
+                ++n.evals;
+            }, threads_);
+            TRACE_DEBUG("diag_graph_wave", wave.size());
+        }
+    }
+
+    // Value of node `id` (computed on demand). Throws std::bad_any_cast on a type mismatch.
+    template <typename T>
+    const T& get(NodeId id) {
+        if (!nodes_[id].done) request({id});
+        return std::any_cast<const T&>(nodes_[id].value);
+    }
+
+    // Drop the memoized value of `id` and of everything downstream of it.
+    void invalidate(NodeId id) {
+        std::vector<char> dirty(nodes_.size(), 0);
+        dirty[id] = 1;
+        for (NodeId k=id; k<nodes_.size(); ++k) {
+            for (NodeId d : nodes_[k].deps) if (dirty[d]) dirty[k] = 1;
+            if (dirty[k]) { nodes_[k].done = false; nodes_[k].value.reset(); }
+        }
+    }
+
+    bool computed(NodeId id) const            { return nodes_[id].done; }
+    std::size_t evaluations(NodeId id) const  { return nodes_[id].evals; }
+    const std::string& name(NodeId id) const  { return nodes_[id].name; }
+    std::size_t size() const                  { return nodes_.size(); }
+
+private:
+    struct Node {
+        std::string name;
+        std::vector<NodeId> deps;
+        std::function<std::any(unsigned)> eval;
+        std::any value;
+        bool done{false};
+        std::size_t evals{0};
+    };
+    std::vector<Node> nodes_;
+    unsigned threads_;
+};
+
+// ---- Checkpoint curvature stack ---------------------------------------------------
+
+// XY slice at fixed (t0, z0), same lattice as sample_xy
+struct SliceSpec {
+    real t0{0}, z0{0};
+    real x0{-1}, y0{-1}, dx{real(0.05)}, dy{real(0.05)};
+    std::size_t nx{64}, ny{64};
+};
+
+// Per-cell curvature kept after the Riemann pass (Riemann itself is 256 reals/cell)
+struct CurvCell {
+    mat4 ricci;
+    real riemann_frob{0};
+};
+
+struct CurvatureNodes {
+    DiagGraph::NodeId packs, gamma, curv;        // per-cell intermediates
+    DiagGraph::NodeId einstein, stress;          // per-cell tensors (stress needs events)
+    DiagGraph::NodeId scalar_R, riemann_frob;    // Grid2D
+    DiagGraph::NodeId gamma_frob;                // Grid2D, ||Γ||_F
+    DiagGraph::NodeId residual;                  // Grid2D, ||G − κT||_F (needs events)
+};
+
+inline Grid2D make_grid(const SliceSpec& S) {
+    Grid2D G; G.nx=S.nx; G.ny=S.ny; G.x0=S.x0; G.y0=S.y0; G.dx=S.dx; G.dy=S.dy; G.t0=S.t0; G.z0=S.z0;
+    G.val.assign(S.nx*S.ny, real(0));
+    return G;
+}
+
+// fn(k, x) for every cell k = i*ny + j, split over `threads`
+template <typename Fn>
+inline void for_cells(const SliceSpec& S, unsigned threads, Fn&& fn) {
+    rslm::par::parallel_for(S.nx, [&](std::size_t b, std::size_t e) {
+        vec4 x(S.t0, S.x0, S.y0, S.z0);
+        for (std::size_t i=b;i<e;++i) {
+            x.v[2] = S.y0 + real(i)*S.dy;
+            for (std::size_t j=0;j<S.ny;++j) {
+                x.v[1] = S.x0 + real(j)*S.dx;
+                fn(i*S.ny + j, x);
+            }
+        }
+    }, threads, 1);
+}
+
+/**
+ * Register the curvature stack for slice S. evs/P may be null; then the
+ * stress and residual nodes are not added (their ids are DiagGraph::npos).
+ */
+inline CurvatureNodes add_curvature_nodes(DiagGraph& g, const IMetricField& F, const SliceSpec& S,
+                                          const std::vector<rslm::phys::Event>* evs = nullptr,
+                                          const rslm::phys::TSParams* P = nullptr)
+{
+    using rslm::conn::MetricPack;
+    using rslm::conn::Gamma;
+    CurvatureNodes N{};
+    const std::size_t ncell = S.nx * S.ny;
+
+    N.packs = g.add("packs", {}, [&F, S, ncell](unsigned t) {
+        std::vector<MetricPack> v(ncell);
+        for_cells(S, t, [&](std::size_t k, const vec4& x) { v[k] = rslm::conn::prepare_metric(F, x); });
+        return v;
+    });
+    N.gamma = g.add("gamma", {N.packs}, [&g, id = N.packs, ncell](unsigned t) {
+        const auto& packs = g.get<std::vector<MetricPack>>(id);
+        std::vector<Gamma> v(ncell);
+        rslm::par::parallel_for(ncell, [&](std::size_t b, std::size_t e) {
+            for (std::size_t k=b;k<e;++k) v[k] = rslm::conn::christoffel(packs[k]);
+        }, t);
+        return v;
+    });
+    // riemann_at with the centre Γ taken from the gamma node (same values, bitwise)
+    N.curv = g.add("curvature", {N.gamma}, [&g, &F, S, id = N.gamma, ncell](unsigned t) {
+        const auto& gam = g.get<std::vector<Gamma>>(id);
+        std::vector<CurvCell> v(ncell);
+        for_cells(S, t, [&](std::size_t k, const vec4& x) {
+            Gamma dG[4];
+            for (int a=0;a<4;++a) dG[a] = rslm::curv::dGamma_dir(F, x, a);
+            auto Rm = rslm::curv::riemann_from_gamma(gam[k], dG);
+            v[k].ricci = rslm::curv::ricci(Rm);
+            v[k].riemann_frob = rslm::curv::frob_riemann(Rm);
+        });
+        return v;
+    });
+    N.scalar_R = g.add("scalar_R", {N.packs, N.curv}, [&g, N, S](unsigned) {
+        const auto& packs = g.get<std::vector<MetricPack>>(N.packs);
+        const auto& curv  = g.get<std::vector<CurvCell>>(N.curv);
+        Grid2D G = make_grid(S);
+        for (std::size_t k=0;k<G.val.size();++k) G.val[k] = rslm::curv::scalar(packs[k].g_inv, curv[k].ricci);
+        return G;
+    });
+    N.riemann_frob = g.add("riemann_frob", {N.curv}, [&g, N, S](unsigned) {
+        const auto& curv = g.get<std::vector<CurvCell>>(N.curv);
+        Grid2D G = make_grid(S);
+        for (std::size_t k=0;k<G.val.size();++k) G.val[k] = curv[k].riemann_frob;
+        return G;
+    });
+    N.gamma_frob = g.add("gamma_frob", {N.gamma}, [&g, N, S](unsigned) {
+        const auto& gam = g.get<std::vector<Gamma>>(N.gamma);
+        Grid2D G = make_grid(S);
+        for (std::size_t k=0;k<G.val.size();++k) {
+            long double s = 0;
+            for (int m=0;m<4;++m) for (int a=0;a<4;++a) for (int b=0;b<4;++b) {
+                long double v = gam[k].G[m][a][b]; s += v*v;
+            }
+            G.val[k] = real(std::sqrt(s));
+        }
+        return G;
+    });
+    // G_{μν} = R_{μν} − ½ g_{μν} R
+    N.einstein = g.add("einstein", {N.packs, N.scalar_R, N.curv}, [&g, N](unsigned) {
+        const auto& packs = g.get<std::vector<MetricPack>>(N.packs);
+        const auto& curv  = g.get<std::vector<CurvCell>>(N.curv);
+        const auto& R     = g.get<Grid2D>(N.scalar_R);
+        std::vector<sym4> v(packs.size());
+        for (std::size_t k=0;k<v.size();++k)
+            for (int i=0;i<4;++i) for (int j=0;j<4;++j)
+                v[k].m[i][j] = curv[k].ricci.m[i][j] - real(0.5) * packs[k].g.m[i][j] * R.val[k];
+        return v;
+    });
+
+    N.stress = N.residual = DiagGraph::npos;
+    if (evs && P) {
+        N.stress = g.add("stress", {}, [&F, S, ncell, evs, P](unsigned t) {
+            std::vector<mat4> v(ncell);
+            for_cells(S, t, [&](std::size_t k, const vec4& x) { v[k] = rslm::phys::stress_energy_at(F, *evs, x, *P); });
+            return v;
+        });
+        N.residual = g.add("residual", {N.einstein, N.stress}, [&g, N, S, P](unsigned) {
+            const auto& Gt = g.get<std::vector<sym4>>(N.einstein);
+            const auto& T  = g.get<std::vector<mat4>>(N.stress);
+            Grid2D G = make_grid(S);
+            for (std::size_t k=0;k<G.val.size();++k) {
+                mat4 R{};
+                for (int i=0;i<4;++i) for (int j=0;j<4;++j) R.m[i][j] = Gt[k].m[i][j] - P->kappa * T[k].m[i][j];
+                G.val[k] = rslm::phys::frob(R);
+            }
+            return G;
+        });
+    }
+    return N;
+}
+
+// ---- Exporter nodes (value: bool success) -------------------------------------------
+
+template <typename Palette = Thermal5>
+inline DiagGraph::NodeId add_export_ppm(DiagGraph& g, DiagGraph::NodeId grid, std::string path) {
+    return g.add("ppm:" + path, {grid}, [&g, grid, path](unsigned) {
+        return save_ppm<Palette>(g.get<Grid2D>(grid), path);
+    });
+}
+
+inline DiagGraph::NodeId add_export_obj(DiagGraph& g, DiagGraph::NodeId grid, std::string path, double scale = 1.0) {
+    return g.add("obj:" + path, {grid}, [&g, grid, path, scale](unsigned) {
+        return save_obj_surface(g.get<Grid2D>(grid), path, scale);
+    });
+}
+
+inline DiagGraph::NodeId add_export_csv(DiagGraph& g, DiagGraph::NodeId grid, std::string path) {
+    return g.add("csv:" + path, {grid}, [&g, grid, path](unsigned) {
+        return save_csv(g.get<Grid2D>(grid), path);
+    });
+}
+
+} // namespace rslm::diag
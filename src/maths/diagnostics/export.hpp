@@ -7,7 +7,9 @@
  *  - ASCII : matrix style (ny columns per line), good for quick diffs
  *  - OBJ   : 3D surface with z = scale * value, vertices laid on (x,y)
  *
- * All files are plain text. No JSON.
+ * All files are plain text. No JSON. Numbers are formatted with to_chars
+ * (text_writer.hpp): shortest round-trip where we used %.17g, identical
+ * bytes for %.6e / %g. `threads` > 1 formats row blocks in parallel.
  */
 
 #include <cstdio>
@@ -17,6 +19,7 @@
 #include "config.hpp"
 #include "trace.hpp"
 #include "grid.hpp"
+#include "text_writer.hpp"
 
 namespace rslm::diag {
 
@@ -25,36 +28,37 @@ inline void ensure_dir(const std::filesystem::path& p) {
     std::filesystem::create_directories(p, ec);
 }
 
-inline bool save_csv(const Grid2D& G, const std::string& path) {
+inline bool save_csv(const Grid2D& G, const std::string& path, unsigned threads = 1) {
     ensure_dir(std::filesystem::path(path).parent_path());
     std::FILE* f = std::fopen(path.c_str(), "w");
     if (!f) return false;
-    std::fprintf(f, "x,y,value\n");
-    for (std::size_t i=0;i<G.nx;++i) {
-        for (std::size_t j=0;j<G.ny;++j) {
-            double x = double(G.x0 + j*G.dx);
-            double y = double(G.y0 + i*G.dy);
-            double v = double(G.at(i,j));
-            std::fprintf(f, "%.17g,%.17g,%.17g\n", x, y, v);
-        }
-    }
-    std::fclose(f);
+    bool ok = std::fputs("x,y,value\n", f) >= 0;
+    // one row per cell
+    ok = write_rows(f, G.nx*G.ny, [&](std::size_t k, TextBuf& b) {
+        std::size_t i = k / G.ny, j = k % G.ny;
+        b.num(double(G.x0 + j*G.dx)); b.put(',');
+        b.num(double(G.y0 + i*G.dy)); b.put(',');
+        b.num(double(G.at(i,j)));     b.put('\n');
+    }, threads) && ok;
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) { TRACE_WARN("save_csv_failed", path); return false; }
     TRACE_INFO("save_csv", path);
     return true;
 }
 
-inline bool save_ascii(const Grid2D& G, const std::string& path) {
+inline bool save_ascii(const Grid2D& G, const std::string& path, unsigned threads = 1) {
     ensure_dir(std::filesystem::path(path).parent_path());
     std::FILE* f = std::fopen(path.c_str(), "w");
     if (!f) return false;
-    for (std::size_t i=0;i<G.nx;++i) {
+    bool ok = write_rows(f, G.nx, [&](std::size_t i, TextBuf& b) {
         for (std::size_t j=0;j<G.ny;++j) {
-            double v = double(G.at(i,j));
-            std::fprintf(f, (j+1<G.ny) ? "%.6e " : "%.6e", v);
+            b.sci(double(G.at(i,j)), 6);
+            if (j+1<G.ny) b.put(' ');
         }
-        std::fprintf(f, "\n");
-    }
-    std::fclose(f);
+        b.put('\n');
+    }, threads, 64);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) { TRACE_WARN("save_ascii_failed", path); return false; }
     TRACE_INFO("save_ascii", path);
     return true;
 }
@@ -64,32 +68,38 @@ inline bool save_ascii(const Grid2D& G, const std::string& path) {
  * - Vertices: (x, y, z) with z = scale*value
  * - Faces: two triangles per quad
  */
-inline bool save_obj_surface(const Grid2D& G, const std::string& path, double scale = 1.0) {
+inline bool save_obj_surface(const Grid2D& G, const std::string& path, double scale = 1.0,
+                             unsigned threads = 1) {
     ensure_dir(std::filesystem::path(path).parent_path());
     std::FILE* f = std::fopen(path.c_str(), "w");
     if (!f) return false;
 
-    std::fprintf(f, "# RSLM surface OBJ: z = %g * value\n", scale);
-    // vertices
-    for (std::size_t i=0;i<G.nx;++i) {
-        for (std::size_t j=0;j<G.ny;++j) {
-            double x = double(G.x0 + j*G.dx);
-            double y = double(G.y0 + i*G.dy);
-            double z = scale * double(G.at(i,j));
-            std::fprintf(f, "v %.17g %.17g %.17g\n", x, y, z);
-        }
+    bool ok = true;
+    {
+        TextBuf h(64);
+        h.put("# RSLM surface OBJ: z = "); h.gen(scale, 6); h.put(" * value\n");
+        ok = h.flush_to(f);
     }
-    // simple grid faces (1-based indices)
+    // vertices
+    ok = write_rows(f, G.nx*G.ny, [&](std::size_t k, TextBuf& b) {
+        std::size_t i = k / G.ny, j = k % G.ny;
+        b.put("v ");
+        b.num(double(G.x0 + j*G.dx));         b.put(' ');
+        b.num(double(G.y0 + i*G.dy));         b.put(' ');
+        b.num(scale * double(G.at(i,j)));     b.put('\n');
+    }, threads) && ok;
+    // simple grid faces (1-based indices), one row per quad
     auto vid = [&](std::size_t i, std::size_t j) { return int(i*G.ny + j + 1); };
-    for (std::size_t i=0;i+1<G.nx;++i) {
-        for (std::size_t j=0;j+1<G.ny;++j) {
-            int v00 = vid(i,j),   v01 = vid(i,j+1);
-            int v10 = vid(i+1,j), v11 = vid(i+1,j+1);
-            std::fprintf(f, "f %d %d %d\n", v00, v01, v11);
-            std::fprintf(f, "f %d %d %d\n", v00, v11, v10);
-        }
-    }
-    std::fclose(f);
+    const std::size_t qx = G.nx ? G.nx-1 : 0, qy = G.ny ? G.ny-1 : 0;
+    ok = write_rows(f, qx*qy, [&](std::size_t q, TextBuf& b) {
+        std::size_t i = q / qy, j = q % qy;
+        int v00 = vid(i,j),   v01 = vid(i,j+1);
+        int v10 = vid(i+1,j), v11 = vid(i+1,j+1);
+        b.put("f "); b.integer(v00); b.put(' '); b.integer(v01); b.put(' '); b.integer(v11); b.put('\n');
+        b.put("f "); b.integer(v00); b.put(' '); b.integer(v11); b.put(' '); b.integer(v10); b.put('\n');
+    }, threads) && ok;
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) { TRACE_WARN("save_obj_failed", path); return false; }
     TRACE_INFO("save_obj", path);
     return true;
 }
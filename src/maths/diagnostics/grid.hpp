@@ -27,6 +27,7 @@ using rslm::cfg::real;
 using rslm::linalg::vec4;
 using rslm::linalg::mat4;
 using rslm::field::IMetricField;
+using rslm::field::MetricFieldLike;
 
 struct Grid2D {
     // origin at (x0,y0), spacing (dx,dy), size nx × ny (row-major: i=row/y, j=col/x)
@@ -41,28 +42,40 @@ struct Grid2D {
 
 // ---- Curvature scalars ------------------------------------------------------
 
+// Statically dispatched callbacks: sample_xy(concrete_field, ..., CurvScalar{})
+// inlines the field's g() into the whole curvature stencil.
+struct CurvScalar {
+    template <MetricFieldLike Fd>
+    real operator()(const Fd& F, const vec4& x) const {
+        auto P = rslm::conn::prepare_metric(F, x);
+        auto Rm = rslm::curv::riemann_at(F, x);
+        auto Rc = rslm::curv::ricci(Rm);
+        return rslm::curv::scalar(P.g_inv, Rc);
+    }
+};
+
+struct CurvRiemannFrob {
+    template <MetricFieldLike Fd>
+    real operator()(const Fd& F, const vec4& x) const {
+        auto Rm = rslm::curv::riemann_at(F, x);
+        return rslm::curv::frob_riemann(Rm);
+    }
+};
+
 // Scalar curvature R(x) using field F
-inline real curv_scalar(const IMetricField& F, const vec4& x) {
-    auto P = rslm::conn::prepare_metric(F, x);
-    auto Rm = rslm::curv::riemann_at(F, x);
-    auto Rc = rslm::curv::ricci(Rm);
-    return rslm::curv::scalar(P.g_inv, Rc);
-}
+inline real curv_scalar(const IMetricField& F, const vec4& x) { return CurvScalar{}(F, x); }
 
 // Frobenius norm ||R||_F at x
-inline real curv_riemann_frob(const IMetricField& F, const vec4& x) {
-    auto Rm = rslm::curv::riemann_at(F, x);
-    return rslm::curv::frob_riemann(Rm);
-}
+inline real curv_riemann_frob(const IMetricField& F, const vec4& x) { return CurvRiemannFrob{}(F, x); }
 
 // ---- Generic XY sampler -----------------------------------------------------
 
 /**
  * Sample a scalar function s(x) on an XY slice at fixed (t0,z0).
- * f must be: real f(const IMetricField&, const vec4&).
+ * f must be callable as real f(const Fd&, const vec4&); Fd is F's static type.
  */
-template <typename ScalarFn>
-inline Grid2D sample_xy(const IMetricField& F, real t0, real z0,
+template <typename ScalarFn, MetricFieldLike Fd>
+Grid2D sample_xy(const Fd& F, real t0, real z0,
                         real x0, real y0, real dx, real dy,
                         std::size_t nx, std::size_t ny,
                         ScalarFn f)
@@ -80,6 +93,15 @@ inline Grid2D sample_xy(const IMetricField& F, real t0, real z0,
     return G;
 }
 
+// Scalar callbacks passed as plain functions (curv_scalar, curv_riemann_frob, ...).
+using ScalarFnPtr = real (*)(const IMetricField&, const vec4&);
+
+#if defined(RSLM_PRECOMPILED)
+// Instantiated once in the rslm_maths library (kernels.cpp).
+extern template Grid2D sample_xy<ScalarFnPtr, IMetricField>(const IMetricField&, real, real, real, real, real, real,
+                                                            std::size_t, std::size_t, ScalarFnPtr);
+#endif
+
 // ---- Simple stats -----------------------------------------------------------
 
 struct Stats {
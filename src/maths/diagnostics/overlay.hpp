@@ -3,7 +3,7 @@
  * RSLM Maths — diagnostics/overlay.hpp
  * ------------------------------------
  * Build overlay masks (polyline) from a sequence of vec4 points on an XY slice.
- * Also export path CSV.
+ * Also export path CSV (to_chars shortest round-trip, see text_writer.hpp).
  */
 
 #include <vector>
@@ -14,21 +14,27 @@
 
 #include "linalg.hpp"
 #include "grid.hpp"
+#include "text_writer.hpp"
+#include "trace.hpp"
 
 namespace rslm::diag {
 
 using rslm::linalg::vec4;
 
-inline bool save_path_csv(const std::vector<vec4>& path, const std::string& file) {
+inline bool save_path_csv(const std::vector<vec4>& path, const std::string& file, unsigned threads = 1) {
     std::FILE* f = std::fopen(file.c_str(), "w");
     if (!f) return false;
-    std::fprintf(f, "t,x,y,z\n");
-    for (auto& p : path) {
-        std::fprintf(f, "%.17g,%.17g,%.17g,%.17g\n",
-                     double(p.v[0]), double(p.v[1]), double(p.v[2]), double(p.v[3]));
-    }
-    std::fclose(f);
-    return true;
+    bool ok = std::fputs("t,x,y,z\n", f) >= 0;
+    ok = write_rows(f, path.size(), [&](std::size_t k, TextBuf& b) {
+        const vec4& p = path[k];
+        b.num(double(p.v[0])); b.put(',');
+        b.num(double(p.v[1])); b.put(',');
+        b.num(double(p.v[2])); b.put(',');
+        b.num(double(p.v[3])); b.put('\n');
+    }, threads) && ok;
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) TRACE_WARN("save_path_csv_failed", file);
+    return ok;
 }
 
 /** Build an overlay mask (same size as grid) from a polyline of points on XY. */
@@ -0,0 +1,234 @@
+#pragma once
+/**
+ * RSLM Maths — diagnostics/qmc_integrate.hpp
+ * ------------------------------------------
+ * Randomized quasi-Monte Carlo integral of a scalar diagnostic s(F, x) over an
+ * axis-aligned spacetime box [lo, hi] (axes with lo == hi are held fixed, so
+ * an XY slice is the box (t0,x0,y0,z0)–(t0,x1,y1,z0)).
+ *
+ *  - R independently scrambled replicates (Sobol or Halton); the estimate is
+ *    their mean and the error the replicate standard error s_R / √R
+ *  - points are drawn in rounds that double the count per replicate
+ *    (power-of-two blocks keep Sobol balanced), every round evaluated as one
+ *    parallel batch; stop once stderr ≤ max(abs_tol, rel_tol·|I|)
+ *  - optional importance sampling from a cheap proxy q(F, x) ≥ 0 on a coarse
+ *    cell grid: density ∝ q(cell centre) + floor·mean(q), sampled by
+ *    conditional inversion per axis (keeps the QMC stratification)
+ *
+ * Integrands: CurvScalar / CurvRiemannFrob (grid.hpp), EinsteinResidualSq
+ * below, or any callable real(const Fd&, const vec4&). MetricGradProxy is a
+ * proxy that costs 8 metric evaluations, against 33–81 for curvature.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "field.hpp"
+#include "deriv.hpp"
+#include "parallel.hpp"
+#include "qmc.hpp"
+#include "einstein_fit.hpp"
+#include "trace.hpp"
+
+namespace rslm::diag {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::field::MetricFieldLike;
+
+enum class QmcSequence { kSobol, kHalton };
+
+struct QmcOptions {
+    QmcSequence seq{QmcSequence::kSobol};
+    std::size_t replicates{8};
+    std::size_t n0{64};                 // points per replicate in the first round
+    std::size_t max_points{1u << 16};   // per replicate
+    real rel_tol{real(1e-3)};
+    real abs_tol{0};
+    std::uint64_t seed{1};
+    std::size_t is_cells{8};            // importance grid cells per active axis
+    real is_floor{real(0.1)};           // defensive share of the uniform density
+    unsigned threads{0};
+};
+
+struct QmcResult {
+    real integral{0};                   // ∫ s dV over the active axes
+    real std_error{0};                    // replicate standard error of `integral`
+    std::size_t points{0};              // per replicate
+    std::size_t evals{0};               // integrand calls
+    std::size_t proxy_evals{0};
+    bool converged{false};
+};
+
+// ‖G - κT‖²_F, κ and sources from P
+struct EinsteinResidualSq {
+    const std::vector<rslm::phys::Event>* evs{nullptr};
+    rslm::phys::TSParams P{};
+    real operator()(const rslm::field::IMetricField& F, const vec4& x) const {
+        real r = rslm::phys::residual_norm(F, *evs, x, P);
+        return r * r;
+    }
+};
+
+// ‖∂g‖_F: first-derivative size as a stand-in for where curvature lives
+struct MetricGradProxy {
+    template <MetricFieldLike Fd>
+    real operator()(const Fd& F, const vec4& x) const {
+        auto dg = rslm::deriv::dmetric4(F, x);
+        real s = 0;
+        for (int a=0;a<4;++a) for (int i=0;i<4;++i) for (int j=0;j<4;++j) s += dg.dg[a].m[i][j] * dg.dg[a].m[i][j];
+        return std::sqrt(s);
+    }
+};
+
+namespace detail {
+
+// Piecewise-constant density on K^d cells of the unit cube, sampled by inverting
+// the marginal over axis 0, then axis 1 given the axis-0 cell, and so on.
+struct CellDensity {
+    int d{0};
+    std::size_t K{1};
+    std::vector<std::vector<real>> mass;    // mass[l][prefix index over axes 0..l]
+
+    bool empty() const { return mass.empty(); }
+
+    // u → warped point w (in place); returns the density at w
+    real warp(real* u) const {
+        std::size_t j = 0, stride = 1;
+        real total = 0;
+        for (real m : mass[0]) total += m;
+        real parent = total;
+        for (int l=0; l<d; ++l) {
+            const std::vector<real>& M = mass[std::size_t(l)];
+            const real target = u[l] * parent;
+            real cum = 0;
+            std::size_t i = 0;
+            for (; i+1<K; ++i) {
+                const real m = M[j + stride*i];
+                if (cum + m > target) break;
+                cum += m;
+            }
+            const real m = M[j + stride*i];
+            const real f = m > 0 ? std::clamp((target - cum) / m, real(0), std::nextafter(real(1), real(0))) : real(0.5);
+            u[l] = (real(i) + f) / real(K);
+            j += stride * i;
+            stride *= K;
+            parent = m;
+        }
+        return parent / total * real(stride);
+    }
+};
+
+} // namespace detail
+
+/**
+ * ∫_{[lo,hi]} s(F, x) dV by scrambled QMC; q is the importance proxy (pass
+ * nullptr for plain QMC).
+ */
+template <typename ScalarFn, MetricFieldLike Fd, typename ProxyFn = std::nullptr_t>
+QmcResult qmc_integrate(const Fd& F, const vec4& lo, const vec4& hi, ScalarFn s,
+                        const QmcOptions& opt = {}, ProxyFn q = nullptr)
+{
+    QmcResult res;
+    int axis[4], d = 0;
+    real vol = 1;
+    for (int a=0;a<4;++a) if (hi.v[a] != lo.v[a]) { axis[d++] = a; vol *= hi.v[a] - lo.v[a]; }
+    auto to_x = [&](const real* w) {
+        vec4 x = lo;
+        for (int k=0;k<d;++k) x.v[axis[k]] = lo.v[axis[k]] + w[k] * (hi.v[axis[k]] - lo.v[axis[k]]);
+        return x;
+    };
+    if (d == 0) {                                   // a single point: the "integral" is its value
+        res.integral = s(F, lo); res.evals = 1; res.points = 1; res.converged = true;
+        return res;
+    }
+
+    // importance cells from the proxy
+    detail::CellDensity dens;
+    if constexpr (!std::is_same_v<ProxyFn, std::nullptr_t>) {
+        const std::size_t K = std::max<std::size_t>(1, opt.is_cells);
+        std::size_t ncell = 1;
+        for (int k=0;k<d;++k) ncell *= K;
+        std::vector<real> qv(ncell);
+        rslm::par::parallel_for(ncell, [&](std::size_t b, std::size_t e) {
+            real w[4];
+            for (std::size_t c=b;c<e;++c) {
+                std::size_t r = c;
+                for (int k=0;k<d;++k) { w[k] = (real(r % K) + real(0.5)) / real(K); r /= K; }
+                qv[c] = std::max(real(0), q(F, to_x(w)));
+            }
+        }, opt.threads, 4);
+        res.proxy_evals = ncell;
+        long double qs = 0;
+        for (real v : qv) qs += v;
+        const real fl = (qs > 0 ? real(qs / ncell) : real(1)) * std::max(opt.is_floor, real(1e-6));
+        dens.d = d; dens.K = K;
+        dens.mass.resize(std::size_t(d));
+        dens.mass[std::size_t(d-1)].resize(ncell);
+        for (std::size_t c=0;c<ncell;++c) dens.mass[std::size_t(d-1)][c] = qv[c] + fl;
+        std::size_t n = ncell;
+        for (int l=d-2; l>=0; --l) {                // marginalize the highest axis
+            n /= K;
+            auto& M = dens.mass[std::size_t(l)];
+            const auto& C = dens.mass[std::size_t(l+1)];
+            M.assign(n, real(0));
+            for (std::size_t i=0;i<K;++i) for (std::size_t j=0;j<n;++j) M[j] += C[j + n*i];
+        }
+    }
+
+    const std::size_t R = std::max<std::size_t>(2, opt.replicates);
+    std::vector<rslm::rng::Sobol> sob;
+    std::vector<rslm::rng::Halton> hal;
+    for (std::size_t r=0;r<R;++r) {
+        const std::uint64_t seed = opt.seed * 0x9e3779b97f4a7c15ull + r + 1;
+        if (opt.seq == QmcSequence::kSobol) sob.emplace_back(d, seed);
+        else hal.emplace_back(d, seed);
+    }
+
+    std::vector<long double> sum(R, 0.0L);
+    std::vector<real> val;
+    std::size_t have = 0, want = std::max<std::size_t>(1, opt.n0);
+    const std::size_t cap = std::max(want, opt.max_points);
+    while (true) {
+        const std::size_t m = want - have;
+        val.assign(R * m, real(0));
+        rslm::par::parallel_for(R * m, [&](std::size_t b, std::size_t e) {
+            real w[4];
+            for (std::size_t k=b;k<e;++k) {
+                const std::size_t r = k / m, i = have + k % m;
+                if (opt.seq == QmcSequence::kSobol) sob[r].point(std::uint32_t(i), w);
+                else hal[r].point(std::uint32_t(i), w);
+                real pdf = 1;
+                if (!dens.empty()) pdf = dens.warp(w);
+                val[k] = s(F, to_x(w)) / pdf;
+            }
+        }, opt.threads, 8);
+        for (std::size_t r=0;r<R;++r)
+            for (std::size_t i=0;i<m;++i) sum[r] += val[r*m + i];
+        have = want;
+        res.evals += R * m;
+
+        long double mean = 0, var = 0;
+        for (std::size_t r=0;r<R;++r) mean += sum[r] / have;
+        mean /= R;
+        for (std::size_t r=0;r<R;++r) { long double dv = sum[r] / have - mean; var += dv*dv; }
+        var /= (R - 1);
+        res.integral = real(mean * vol);
+        res.std_error = real(std::sqrt(var / R) * std::fabs(vol));
+        res.points = have;
+        if (!std::isfinite(res.integral)) { TRACE_WARN("qmc_nonfinite", res.integral); break; }
+        if (res.std_error <= std::max(opt.abs_tol, opt.rel_tol * std::fabs(res.integral))) { res.converged = true; break; }
+        if (have >= cap) break;
+        want = std::min(cap, have * 2);
+    }
+    TRACE_DEBUG("qmc_points", res.points);
+    return res;
+}
+
+} // namespace rslm::diag
@@ -0,0 +1,281 @@
+#pragma once
+/**
+ * RSLM Maths — diagnostics/shm_store.hpp
+ * --------------------------------------
+ * Shared-memory frame store for producer/consumer pipelines (POSIX shm).
+ * The training process publishes Grid2D frames and trajectory chunks; a
+ * diagnostics process maps the same segment and reads the latest frames
+ * zero-copy, with no CSV round trip.
+ *
+ *   layout : [StoreHeader][slot 0][slot 1]...   (64-byte aligned)
+ *   slot   : [SlotHeader][payload: real values or vec4 points]
+ *
+ * Publication is a per-slot seqlock. The single writer bumps seq to odd,
+ * writes header + payload, bumps seq to even, then advances latest[kind].
+ * Readers take a view while seq is even and call valid(view) after use; a
+ * changed seq means the slot was overwritten and the read must be retried.
+ * Frame ids start at 1 and map to slot (id - 1) % nslots, so readers can
+ * also walk recent history with frame(id, view).
+ *
+ * One producer per store. Segments carry sizeof(real), so float and double
+ * builds refuse each other's stores.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "grid.hpp"
+#include "trace.hpp"
+
+namespace rslm::diag {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+
+class ShmStore {
+public:
+    enum Kind : std::uint32_t { kGrid = 0, kPath = 1, kKinds = 2 };
+
+    // Grid2D geometry carried with every grid frame
+    struct GridMeta {
+        std::uint64_t nx{0}, ny{0};
+        double x0{0}, y0{0}, dx{1}, dy{1}, t0{0}, z0{0};
+    };
+
+    // Borrowed view of one published frame (points into the mapping)
+    struct FrameView {
+        Kind kind{kGrid};
+        std::uint64_t frame_id{0};
+        std::uint64_t seq{0};
+        std::size_t slot{0};
+        GridMeta grid;                   // kGrid
+        std::uint64_t traj_id{0};        // kPath: first trajectory id of the chunk
+        std::size_t count{0};            // reals (kGrid) or points (kPath)
+        const real* values{nullptr};     // kGrid
+        const vec4* points{nullptr};     // kPath
+    };
+
+    ShmStore() = default;
+    ~ShmStore() { close(); }
+    ShmStore(const ShmStore&) = delete;
+    ShmStore& operator=(const ShmStore&) = delete;
+    ShmStore(ShmStore&& o) noexcept { *this = std::move(o); }
+    ShmStore& operator=(ShmStore&& o) noexcept {
+        if (this != &o) {
+            close();
+            base_ = o.base_; bytes_ = o.bytes_; writer_ = o.writer_; name_ = std::move(o.name_);
+            o.base_ = nullptr; o.bytes_ = 0; o.writer_ = false;
+        }
+        return *this;
+    }
+
+    // Producer: create (or replace) segment `name` ("/rslm_frames") with nslots × slot_bytes payload.
+    bool create(const std::string& name, std::size_t nslots, std::size_t slot_bytes) {
+        close();
+        if (nslots == 0 || slot_bytes == 0) return false;
+        const std::size_t stride = align(sizeof(SlotHeader)) + align(slot_bytes);
+        const std::size_t total  = align(sizeof(StoreHeader)) + nslots * stride;
+
+        ::shm_unlink(name.c_str());
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return false;
+        if (::ftruncate(fd, off_t(total)) != 0) { ::close(fd); ::shm_unlink(name.c_str()); return false; }
+        void* p = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) { ::shm_unlink(name.c_str()); return false; }
+
+        base_ = static_cast<unsigned char*>(p); bytes_ = total; writer_ = true; name_ = name;
+        auto* H = new (base_) StoreHeader{};
+        H->real_size  = sizeof(real);
+        H->nslots     = nslots;
+        H->slot_bytes = align(slot_bytes);
+        H->stride     = stride;
+        for (std::size_t s=0;s<nslots;++s) new (slot_header(s)) SlotHeader{};
+        H->magic.store(kMagic, std::memory_order_release);   // visible last
+        TRACE_INFO("shm_store_create", name);
+        return true;
+    }
+
+    // Consumer: map an existing segment read-only.
+    bool open(const std::string& name) {
+        close();
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) < sizeof(StoreHeader)) { ::close(fd); return false; }
+        void* p = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        base_ = static_cast<unsigned char*>(p); bytes_ = std::size_t(st.st_size); writer_ = false; name_ = name;
+
+        const StoreHeader* H = header();
+        bool ok = H->magic.load(std::memory_order_acquire) == kMagic
+               && H->real_size == sizeof(real)
+               && align(sizeof(StoreHeader)) + H->nslots * H->stride <= bytes_;
+        if (!ok) close();
+        return ok;
+    }
+
+    // Unmap; the producer also removes the name (existing mappings stay valid).
+    void close() {
+        if (base_) ::munmap(base_, bytes_);
+        if (writer_ && !name_.empty()) ::shm_unlink(name_.c_str());
+        base_ = nullptr; bytes_ = 0; writer_ = false; name_.clear();
+    }
+
+    bool is_open() const { return base_ != nullptr; }
+    std::size_t nslots() const { return base_ ? std::size_t(header()->nslots) : 0; }
+    std::size_t slot_bytes() const { return base_ ? std::size_t(header()->slot_bytes) : 0; }
+
+    // ---- Producer ----------------------------------------------------------------
+
+    // Publish a grid frame; returns its frame id (0 if it does not fit or not the writer).
+    std::uint64_t publish_grid(const Grid2D& G) {
+        GridMeta m;
+        m.nx = G.nx; m.ny = G.ny;
+        m.x0 = double(G.x0); m.y0 = double(G.y0); m.dx = double(G.dx); m.dy = double(G.dy);
+        m.t0 = double(G.t0); m.z0 = double(G.z0);
+        return publish(kGrid, m, 0, G.val.data(), G.val.size(), G.val.size() * sizeof(real));
+    }
+
+    // Publish a chunk of trajectory points (e.g. one path, or a batch of positions).
+    std::uint64_t publish_path(const vec4* pts, std::size_t n, std::uint64_t traj_id = 0) {
+        return publish(kPath, GridMeta{}, traj_id, pts, n, n * sizeof(vec4));
+    }
+    std::uint64_t publish_path(const std::vector<vec4>& path, std::uint64_t traj_id = 0) {
+        return publish_path(path.data(), path.size(), traj_id);
+    }
+
+    // ---- Consumer ----------------------------------------------------------------
+
+    std::uint64_t latest_id(Kind k) const {
+        return base_ ? header()->latest[k].load(std::memory_order_acquire) : 0;
+    }
+
+    // View of frame `id` (false if never published, being written, or already overwritten).
+    bool frame(std::uint64_t id, FrameView& v) const {
+        if (!base_ || id == 0) return false;
+        std::size_t s = std::size_t((id - 1) % header()->nslots);
+        const SlotHeader* S = slot_header(s);
+        std::uint64_t seq = S->seq.load(std::memory_order_acquire);
+        if (seq & 1u) return false;
+        v.kind     = Kind(S->kind);
+        v.frame_id = S->frame_id;
+        v.seq      = seq;
+        v.slot     = s;
+        v.grid     = S->grid;
+        v.traj_id  = S->traj_id;
+        v.count    = std::size_t(S->count);
+        v.values   = (v.kind == kGrid) ? reinterpret_cast<const real*>(slot_payload(s)) : nullptr;
+        v.points   = (v.kind == kPath) ? reinterpret_cast<const vec4*>(slot_payload(s)) : nullptr;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return v.frame_id == id && S->seq.load(std::memory_order_relaxed) == seq;
+    }
+
+    bool latest(Kind k, FrameView& v) const { return frame(latest_id(k), v); }
+
+    // True if nothing overwrote the viewed slot since the view was taken.
+    bool valid(const FrameView& v) const {
+        if (!base_) return false;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot_header(v.slot)->seq.load(std::memory_order_relaxed) == v.seq;
+    }
+
+    // Copy the latest grid out (retries while the producer laps the reader).
+    bool read_latest_grid(Grid2D& G, int max_retries = 64) const {
+        for (int r=0;r<max_retries;++r) {
+            FrameView v;
+            if (!latest(kGrid, v)) continue;
+            G.nx = std::size_t(v.grid.nx); G.ny = std::size_t(v.grid.ny);
+            G.x0 = real(v.grid.x0); G.y0 = real(v.grid.y0); G.dx = real(v.grid.dx); G.dy = real(v.grid.dy);
+            G.t0 = real(v.grid.t0); G.z0 = real(v.grid.z0);
+            G.val.resize(v.count);
+            if (v.count) std::memcpy(G.val.data(), v.values, v.count * sizeof(real));
+            if (valid(v)) return true;
+        }
+        return false;
+    }
+
+    bool read_latest_path(std::vector<vec4>& path, std::uint64_t* traj_id = nullptr, int max_retries = 64) const {
+        for (int r=0;r<max_retries;++r) {
+            FrameView v;
+            if (!latest(kPath, v)) continue;
+            path.resize(v.count);
+            if (v.count) std::memcpy(static_cast<void*>(path.data()), v.points, v.count * sizeof(vec4));
+            if (valid(v)) { if (traj_id) *traj_id = v.traj_id; return true; }
+        }
+        return false;
+    }
+
+private:
+    static constexpr std::uint64_t kMagic = 0x31534d48534d5352ull;   // "RSMSHMS1"
+    static constexpr std::size_t kAlign = 64;
+
+    struct StoreHeader {
+        std::atomic<std::uint64_t> magic{0};
+        std::uint64_t real_size{0};
+        std::uint64_t nslots{0};
+        std::uint64_t slot_bytes{0};
+        std::uint64_t stride{0};
+        std::uint64_t next_id{1};                          // writer-private
+        std::atomic<std::uint64_t> latest[kKinds]{};
+    };
+
+    struct SlotHeader {
+        std::atomic<std::uint64_t> seq{0};                 // odd while writing
+        std::uint32_t kind{0};
+        std::uint32_t reserved{0};
+        std::uint64_t frame_id{0};
+        std::uint64_t traj_id{0};
+        std::uint64_t count{0};
+        GridMeta grid;
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shm seqlock needs lock-free 64-bit atomics");
+
+    static constexpr std::size_t align(std::size_t n) { return (n + kAlign - 1) / kAlign * kAlign; }
+
+    StoreHeader* header() const { return reinterpret_cast<StoreHeader*>(base_); }
+    unsigned char* slot_base(std::size_t s) const {
+        return base_ + align(sizeof(StoreHeader)) + s * std::size_t(header()->stride);
+    }
+    SlotHeader* slot_header(std::size_t s) const { return reinterpret_cast<SlotHeader*>(slot_base(s)); }
+    unsigned char* slot_payload(std::size_t s) const { return slot_base(s) + align(sizeof(SlotHeader)); }
+
+    std::uint64_t publish(Kind k, const GridMeta& m, std::uint64_t traj_id,
+                          const void* data, std::size_t count, std::size_t bytes) {
+        if (!base_ || !writer_ || bytes > header()->slot_bytes) return 0;
+        StoreHeader* H = header();
+        std::uint64_t id = H->next_id++;
+        std::size_t s = std::size_t((id - 1) % H->nslots);
+        SlotHeader* S = slot_header(s);
+
+        std::uint64_t seq = S->seq.load(std::memory_order_relaxed);
+        S->seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        S->kind = k; S->frame_id = id; S->traj_id = traj_id; S->count = count; S->grid = m;
+        if (bytes) std::memcpy(slot_payload(s), data, bytes);
+        S->seq.store(seq + 2, std::memory_order_release);
+        H->latest[k].store(id, std::memory_order_release);
+        return id;
+    }
+
+    unsigned char* base_{nullptr};
+    std::size_t bytes_{0};
+    bool writer_{false};
+    std::string name_;
+};
+
+} // namespace rslm::diag
@@ -19,9 +19,10 @@ namespace rslm::diag {
 using rslm::cfg::real;
 using rslm::linalg::vec4;
 using rslm::field::IMetricField;
+using rslm::field::MetricFieldLike;
 
-template <typename ScalarFn>
-inline Grid2D sample_plane(const IMetricField& F,
+template <typename ScalarFn, MetricFieldLike Fd>
+Grid2D sample_plane(const Fd& F,
                            int axi, int axj,
                            const std::array<real,4>& fixed, // all 4 coords; axi/axj overwritten
                            real u0, real v0, real du, real dv,
@@ -46,9 +47,14 @@ inline Grid2D sample_plane(const IMetricField& F,
     return G;
 }
 
+#if defined(RSLM_PRECOMPILED)
+extern template Grid2D sample_plane<ScalarFnPtr, IMetricField>(const IMetricField&, int, int, const std::array<real,4>&,
+                                                               real, real, real, real, std::size_t, std::size_t, ScalarFnPtr);
+#endif
+
 /** XZ slice at fixed (t0, y0). */
-template <typename ScalarFn>
-inline Grid2D sample_xz(const IMetricField& F,
+template <typename ScalarFn, MetricFieldLike Fd>
+inline Grid2D sample_xz(const Fd& F,
                         real t0, real y0,
                         real x0, real z0, real dx, real dz,
                         std::size_t nx, std::size_t nz,
@@ -61,8 +67,8 @@ inline Grid2D sample_xz(const IMetricField& F,
 }
 
 /** TY slice at fixed (x0, z0). */
-template <typename ScalarFn>
-inline Grid2D sample_ty(const IMetricField& F,
+template <typename ScalarFn, MetricFieldLike Fd>
+inline Grid2D sample_ty(const Fd& F,
                         real x0, real z0,
                         real t0, real y0, real dt, real dy,
                         std::size_t nt, std::size_t ny,
@@ -0,0 +1,108 @@
+#pragma once
+/**
+ * RSLM Maths — diagnostics/text_writer.hpp
+ * ----------------------------------------
+ * Buffered, locale-free text formatting for the CSV/ASCII/OBJ exporters.
+ *  - TextBuf            : append-only char buffer with std::to_chars numbers
+ *      num(v)           : shortest round-trip (parses back to the same double as %.17g)
+ *      sci(v, p)        : same bytes as printf("%.<p>e")
+ *      gen(v, p)        : same bytes as printf("%.<p>g")
+ *  - write_rows(f, n, row) : format rows into large blocks and fwrite them;
+ *                            with threads > 1 row blocks are formatted in
+ *                            parallel and written in order (same bytes)
+ */
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+
+#include "parallel.hpp"
+
+namespace rslm::diag {
+
+class TextBuf {
+public:
+    explicit TextBuf(std::size_t reserve = std::size_t(1) << 16) { buf_.resize(reserve); }
+
+    void put(char c)              { room(1); buf_[n_++] = c; }
+    void put(std::string_view s)  { room(s.size()); std::copy(s.begin(), s.end(), buf_.begin() + n_); n_ += s.size(); }
+
+    void num(double v) {
+        room(kMaxNum);
+        n_ = std::size_t(std::to_chars(buf_.data() + n_, buf_.data() + buf_.size(), v).ptr - buf_.data());
+    }
+    void sci(double v, int prec) {
+        room(kMaxNum + std::size_t(prec));
+        n_ = std::size_t(std::to_chars(buf_.data() + n_, buf_.data() + buf_.size(), v,
+                                       std::chars_format::scientific, prec).ptr - buf_.data());
+    }
+    void gen(double v, int prec) {
+        room(kMaxNum + std::size_t(prec));
+        n_ = std::size_t(std::to_chars(buf_.data() + n_, buf_.data() + buf_.size(), v,
+                                       std::chars_format::general, prec).ptr - buf_.data());
+    }
+    void integer(long long v) {
+        room(24);
+        n_ = std::size_t(std::to_chars(buf_.data() + n_, buf_.data() + buf_.size(), v).ptr - buf_.data());
+    }
+
+    std::size_t size() const  { return n_; }
+    const char* data() const  { return buf_.data(); }
+    void clear()              { n_ = 0; }
+
+    bool flush_to(std::FILE* f) {
+        bool ok = n_ == 0 || std::fwrite(buf_.data(), 1, n_, f) == n_;
+        n_ = 0;
+        return ok;
+    }
+
+private:
+    static constexpr std::size_t kMaxNum = 32;     // "-1.2345678901234567e-308" + slack
+
+    void room(std::size_t k) {
+        if (n_ + k > buf_.size()) buf_.resize(std::max(buf_.size() * 2, n_ + k));
+    }
+
+    std::vector<char> buf_;
+    std::size_t n_{0};
+};
+
+/**
+ * Emit rows [0, nrows) via row(r, TextBuf&) into f. Serial mode flushes every
+ * ~1 MiB; parallel mode formats `threads` blocks of block_rows at a time.
+ */
+template <typename RowFn>
+inline bool write_rows(std::FILE* f, std::size_t nrows, RowFn&& row,
+                       unsigned threads = 1, std::size_t block_rows = 4096)
+{
+    constexpr std::size_t kFlush = std::size_t(1) << 20;
+    if (threads <= 1 || nrows <= block_rows) {
+        TextBuf b(kFlush + (kFlush >> 2));
+        bool ok = true;
+        for (std::size_t r=0;r<nrows;++r) {
+            row(r, b);
+            if (b.size() >= kFlush) ok = b.flush_to(f) && ok;
+        }
+        return b.flush_to(f) && ok;
+    }
+
+    const std::size_t nblocks = (nrows + block_rows - 1) / block_rows;
+    std::vector<TextBuf> bufs(threads);
+    bool ok = true;
+    for (std::size_t b0=0;b0<nblocks;b0+=threads) {
+        std::size_t nb = std::min<std::size_t>(threads, nblocks - b0);
+        rslm::par::parallel_chunks(nb, nb, [&](std::size_t c, std::size_t, std::size_t) {
+            TextBuf& B = bufs[c];
+            B.clear();
+            std::size_t r0 = (b0 + c) * block_rows, r1 = std::min(nrows, r0 + block_rows);
+            for (std::size_t r=r0;r<r1;++r) row(r, B);
+        }, threads);
+        for (std::size_t c=0;c<nb;++c) ok = bufs[c].flush_to(f) && ok;
+    }
+    return ok;
+}
+
+} // namespace rslm::diag
@@ -0,0 +1,189 @@
+#pragma once
+/**
+ * RSLM Maths — diagnostics/tiled_grid.hpp
+ * ---------------------------------------
+ * Tiled Grid2D with a min/max/mean mip pyramid and region-of-interest readback.
+ *  - TiledGrid(G)     : copies G into fixed square tiles (tile × tile, row-major
+ *                       inside a tile) and builds levels 1..L in parallel; level ℓ
+ *                       cell (i,j) reduces full-res cells [i·2^ℓ, (i+1)·2^ℓ) ×
+ *                       [j·2^ℓ, (j+1)·2^ℓ) (clipped at the border, mean weighted by
+ *                       covered cells, so it is the exact block mean)
+ *  - roi(level, i0, j0, ni, nj, channel) : Grid2D of a window, touching only the
+ *                       tiles it overlaps
+ *  - view(x/y box, max_w, max_h)        : finest level whose window fits the
+ *                       pixel budget, so zooming costs O(visible pixels)
+ *
+ * Indexing follows Grid2D: i = row (y, nx rows), j = column (x, ny columns).
+ * A roi() grid's x0/y0 are the centers of its first cell's covered block.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "config.hpp"
+#include "grid.hpp"
+#include "parallel.hpp"
+
+namespace rslm::diag {
+
+using rslm::cfg::real;
+
+class TiledGrid {
+public:
+    enum Channel { kMean = 0, kMin = 1, kMax = 2 };
+
+    TiledGrid() = default;
+
+    explicit TiledGrid(const Grid2D& G, std::size_t tile = 64, unsigned threads = 0)
+        : tile_(std::max<std::size_t>(1, tile)), x0_(G.x0), y0_(G.y0), dx_(G.dx), dy_(G.dy), t0_(G.t0), z0_(G.z0)
+    {
+        levels_.push_back(make_level(G.nx, G.ny, /*min_max=*/false));
+        Level& L0 = levels_[0];
+        rslm::par::parallel_for(L0.tiles_r, [&](std::size_t b, std::size_t e) {
+            for (std::size_t tr=b;tr<e;++tr)
+                for (std::size_t i=tr*tile_; i<std::min(L0.nx, (tr+1)*tile_); ++i)
+                    for (std::size_t j=0;j<L0.ny;++j)
+                        L0.mean[L0.index(i, j, tile_)] = G.at(i, j);
+        }, threads, 1);
+        while (levels_.back().nx > 1 || levels_.back().ny > 1) build_next(threads);
+    }
+
+    std::size_t levels() const                 { return levels_.size(); }
+    std::size_t nx(std::size_t level = 0) const { return levels_[level].nx; }
+    std::size_t ny(std::size_t level = 0) const { return levels_[level].ny; }
+    std::size_t tile() const                   { return tile_; }
+
+    real at(std::size_t level, std::size_t i, std::size_t j, Channel c = kMean) const {
+        const Level& L = levels_[level];
+        return L.plane(c)[L.index(i, j, tile_)];
+    }
+
+    // Window [i0, i0+ni) × [j0, j0+nj) of `level`, clipped to the level's extent.
+    Grid2D roi(std::size_t level, std::size_t i0, std::size_t j0, std::size_t ni, std::size_t nj,
+               Channel c = kMean) const
+    {
+        const Level& L = levels_[level];
+        i0 = std::min(i0, L.nx); j0 = std::min(j0, L.ny);
+        ni = std::min(ni, L.nx - i0); nj = std::min(nj, L.ny - j0);
+
+        const real s = real(std::size_t(1) << level);
+        Grid2D G;
+        G.nx = ni; G.ny = nj;
+        G.dx = dx_ * s; G.dy = dy_ * s;
+        G.x0 = x0_ + (real(j0) * s + (s - 1) * real(0.5)) * dx_;
+        G.y0 = y0_ + (real(i0) * s + (s - 1) * real(0.5)) * dy_;
+        G.t0 = t0_; G.z0 = z0_;
+        G.val.resize(ni * nj);
+
+        const std::vector<real>& P = L.plane(c);
+        // copy tile-row segments: only tiles overlapping the window are read
+        for (std::size_t i=i0;i<i0+ni;++i) {
+            for (std::size_t j=j0;j<j0+nj;) {
+                std::size_t jend = std::min(j0 + nj, (j / tile_ + 1) * tile_);
+                const real* src = &P[L.index(i, j, tile_)];
+                std::copy(src, src + (jend - j), &G.val[(i - i0) * nj + (j - j0)]);
+                j = jend;
+            }
+        }
+        return G;
+    }
+
+    // World box [xa, xb] × [ya, yb] at the finest level whose window fits max_w × max_h.
+    Grid2D view(real xa, real xb, real ya, real yb, std::size_t max_w, std::size_t max_h,
+                Channel c = kMean) const
+    {
+        if (levels_.empty()) return Grid2D{};
+        const Level& L0 = levels_[0];
+        auto clampi = [](real v, std::size_t n) {
+            if (!(v > 0)) return std::size_t(0);
+            return std::min(n ? n - 1 : 0, std::size_t(v));
+        };
+        std::size_t ja = clampi((std::min(xa, xb) - x0_) / dx_, L0.ny), jb = clampi((std::max(xa, xb) - x0_) / dx_, L0.ny);
+        std::size_t ia = clampi((std::min(ya, yb) - y0_) / dy_, L0.nx), ib = clampi((std::max(ya, yb) - y0_) / dy_, L0.nx);
+        max_w = std::max<std::size_t>(1, max_w); max_h = std::max<std::size_t>(1, max_h);
+
+        std::size_t lv = 0;
+        while (lv + 1 < levels_.size() &&
+               ((jb >> lv) - (ja >> lv) + 1 > max_w || (ib >> lv) - (ia >> lv) + 1 > max_h)) ++lv;
+        return roi(lv, ia >> lv, ja >> lv, (ib >> lv) - (ia >> lv) + 1, (jb >> lv) - (ja >> lv) + 1, c);
+    }
+
+    // Full level as a flat Grid2D
+    Grid2D to_grid(std::size_t level = 0, Channel c = kMean) const {
+        return roi(level, 0, 0, levels_[level].nx, levels_[level].ny, c);
+    }
+
+private:
+    struct Level {
+        std::size_t nx{0}, ny{0};
+        std::size_t tiles_r{0}, tiles_c{0};
+        std::vector<real> mean, vmin, vmax;
+
+        std::size_t index(std::size_t i, std::size_t j, std::size_t T) const {
+            return ((i / T) * tiles_c + (j / T)) * T * T + (i % T) * T + (j % T);
+        }
+        // level 0 keeps only the values (min = max = mean there)
+        const std::vector<real>& plane(Channel c) const {
+            if (vmin.empty()) return mean;
+            return c == kMin ? vmin : (c == kMax ? vmax : mean);
+        }
+    };
+
+    Level make_level(std::size_t nx, std::size_t ny, bool min_max = true) const {
+        Level L;
+        L.nx = nx; L.ny = ny;
+        L.tiles_r = (nx + tile_ - 1) / tile_;
+        L.tiles_c = (ny + tile_ - 1) / tile_;
+        std::size_t n = L.tiles_r * L.tiles_c * tile_ * tile_;
+        L.mean.assign(n, real(0));
+        if (min_max) { L.vmin.assign(n, real(0)); L.vmax.assign(n, real(0)); }
+        return L;
+    }
+
+    void build_next(unsigned threads) {
+        const std::size_t lv = levels_.size();                  // level being built
+        const std::size_t nx0 = levels_[0].nx, ny0 = levels_[0].ny;
+        Level N = make_level((levels_.back().nx + 1) / 2, (levels_.back().ny + 1) / 2);
+        const Level& P = levels_.back();
+        const std::vector<real>& pmin = P.plane(kMin);
+        const std::vector<real>& pmax = P.plane(kMax);
+        // full-res cells covered by row i / column j of level `l`
+        auto span = [](std::size_t k, std::size_t l, std::size_t n0) {
+            std::size_t a = k << l;
+            return real(std::min(n0, (k + 1) << l) - a);
+        };
+        rslm::par::parallel_for(N.tiles_r, [&](std::size_t b, std::size_t e) {
+            for (std::size_t tr=b;tr<e;++tr)
+                for (std::size_t i=tr*tile_; i<std::min(N.nx, (tr+1)*tile_); ++i)
+                    for (std::size_t j=0;j<N.ny;++j) {
+                        real lo = 0, hi = 0, sum = 0, w = 0;
+                        bool first = true;
+                        for (std::size_t di=0;di<2;++di) {
+                            std::size_t pi = 2*i + di;
+                            if (pi >= P.nx) break;
+                            for (std::size_t dj=0;dj<2;++dj) {
+                                std::size_t pj = 2*j + dj;
+                                if (pj >= P.ny) break;
+                                std::size_t k = P.index(pi, pj, tile_);
+                                real cw = span(pi, lv-1, nx0) * span(pj, lv-1, ny0);
+                                if (first) { lo = pmin[k]; hi = pmax[k]; first = false; }
+                                else { lo = std::min(lo, pmin[k]); hi = std::max(hi, pmax[k]); }
+                                sum += cw * P.mean[k];
+                                w += cw;
+                            }
+                        }
+                        std::size_t k = N.index(i, j, tile_);
+                        N.vmin[k] = lo; N.vmax[k] = hi; N.mean[k] = (w > 0) ? sum / w : real(0);
+                    }
+        }, threads, 1);
+        levels_.push_back(std::move(N));
+    }
+
+    std::size_t tile_{64};
+    real x0_{0}, y0_{0}, dx_{1}, dy_{1}, t0_{0}, z0_{0};
+    std::vector<Level> levels_;
+};
+
+} // namespace rslm::diag
@@ -0,0 +1,376 @@
+#include "dispatch.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <algorithm>
+
+namespace rslm::dispatch {
+inline namespace RSLM_KERN_ABI {
+
+namespace {
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define RSLM_BODY inline __attribute__((always_inline))
+#else
+#  define RSLM_BODY inline
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  define RSLM_HAVE_X86_VARIANTS 1
+#  define RSLM_TARGET_AVX2   __attribute__((target("avx2,fma")))
+#  define RSLM_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx2,fma")))
+#else
+#  define RSLM_HAVE_X86_VARIANTS 0
+#endif
+
+// Every variant must give the scalar variant's results bit for bit: the build
+// compiles this file with -ffp-contract=off (CMakeLists.txt), so the FMA-capable
+// targets do not fuse a*b + c.
+#if defined(__GNUC__) && !defined(__clang__)
+#  define RSLM_TARGET_SCALAR __attribute__((optimize("no-tree-vectorize")))
+#else
+#  define RSLM_TARGET_SCALAR
+#endif
+
+// ---- Kernel bodies (one source, compiled per variant) --------------------------
+
+RSLM_BODY void mat4_mul_body(const mat4* A, const mat4* B, mat4* C, std::size_t n) {
+    for (std::size_t k=0;k<n;++k) {
+        const auto& a = A[k].m; const auto& b = B[k].m; auto& c = C[k].m;
+        for (int r=0;r<4;++r)
+            for (int col=0;col<4;++col)
+                c[r][col] = a[r][0]*b[0][col] + a[r][1]*b[1][col] + a[r][2]*b[2][col] + a[r][3]*b[3][col];
+    }
+}
+
+// Laplace expansion by complementary 2×2 minors (no pivoting, no branches).
+RSLM_BODY void inverse_body(const mat4* A, mat4* Ainv, real* det, std::uint8_t* ok, std::size_t n, real eps) {
+    for (std::size_t k=0;k<n;++k) {
+        const auto& a = A[k].m;
+        real s0 = a[0][0]*a[1][1] - a[1][0]*a[0][1];
+        real s1 = a[0][0]*a[1][2] - a[1][0]*a[0][2];
+        real s2 = a[0][0]*a[1][3] - a[1][0]*a[0][3];
+        real s3 = a[0][1]*a[1][2] - a[1][1]*a[0][2];
+        real s4 = a[0][1]*a[1][3] - a[1][1]*a[0][3];
+        real s5 = a[0][2]*a[1][3] - a[1][2]*a[0][3];
+        real c5 = a[2][2]*a[3][3] - a[3][2]*a[2][3];
+        real c4 = a[2][1]*a[3][3] - a[3][1]*a[2][3];
+        real c3 = a[2][1]*a[3][2] - a[3][1]*a[2][2];
+        real c2 = a[2][0]*a[3][3] - a[3][0]*a[2][3];
+        real c1 = a[2][0]*a[3][2] - a[3][0]*a[2][2];
+        real c0 = a[2][0]*a[3][1] - a[3][0]*a[2][1];
+        real d  = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+        bool good = std::fabs(d) > eps;
+        real id = good ? real(1)/d : real(0);
+        auto& b = Ainv[k].m;
+        b[0][0] = ( a[1][1]*c5 - a[1][2]*c4 + a[1][3]*c3) * id;
+        b[0][1] = (-a[0][1]*c5 + a[0][2]*c4 - a[0][3]*c3) * id;
+        b[0][2] = ( a[3][1]*s5 - a[3][2]*s4 + a[3][3]*s3) * id;
+        b[0][3] = (-a[2][1]*s5 + a[2][2]*s4 - a[2][3]*s3) * id;
+        b[1][0] = (-a[1][0]*c5 + a[1][2]*c2 - a[1][3]*c1) * id;
+        b[1][1] = ( a[0][0]*c5 - a[0][2]*c2 + a[0][3]*c1) * id;
+        b[1][2] = (-a[3][0]*s5 + a[3][2]*s2 - a[3][3]*s1) * id;
+        b[1][3] = ( a[2][0]*s5 - a[2][2]*s2 + a[2][3]*s1) * id;
+        b[2][0] = ( a[1][0]*c4 - a[1][1]*c2 + a[1][3]*c0) * id;
+        b[2][1] = (-a[0][0]*c4 + a[0][1]*c2 - a[0][3]*c0) * id;
+        b[2][2] = ( a[3][0]*s4 - a[3][1]*s2 + a[3][3]*s0) * id;
+        b[2][3] = (-a[2][0]*s4 + a[2][1]*s2 - a[2][3]*s0) * id;
+        b[3][0] = (-a[1][0]*c3 + a[1][1]*c1 - a[1][2]*c0) * id;
+        b[3][1] = ( a[0][0]*c3 - a[0][1]*c1 + a[0][2]*c0) * id;
+        b[3][2] = (-a[3][0]*s3 + a[3][1]*s1 - a[3][2]*s0) * id;
+        b[3][3] = ( a[2][0]*s3 - a[2][1]*s1 + a[2][2]*s0) * id;
+        det[k] = d;
+        ok[k]  = std::uint8_t(good);
+    }
+}
+
+RSLM_BODY void christoffel_body(const MetricPack* M, Gamma* out, std::size_t n) {
+    for (std::size_t k=0;k<n;++k) {
+        const auto& gi = M[k].g_inv.m;
+        const auto& dg = M[k].dg.dg;
+        // T[nu][a][b] = ∂_a g_{νb} + ∂_b g_{νa} − ∂_ν g_{ab}
+        real T[4][4][4];
+        for (int nu=0;nu<4;++nu)
+            for (int a=0;a<4;++a)
+                for (int b=0;b<4;++b)
+                    T[nu][a][b] = dg[a].m[nu][b] + dg[b].m[nu][a] - dg[nu].m[a][b];
+        for (int mu=0;mu<4;++mu)
+            for (int a=0;a<4;++a)
+                for (int b=0;b<4;++b)
+                    out[k].G[mu][a][b] = real(0.5) * (gi[mu][0]*T[0][a][b] + gi[mu][1]*T[1][a][b]
+                                                    + gi[mu][2]*T[2][a][b] + gi[mu][3]*T[3][a][b]);
+    }
+}
+
+RSLM_BODY void riemann_body(const Gamma* G, const Gamma* dG, Riemann* out, std::size_t n) {
+    for (std::size_t k=0;k<n;++k) {
+        const auto& g = G[k].G;
+        const Gamma* d = dG + 4*k;
+        for (int mu=0;mu<4;++mu)
+        for (int nu=0;nu<4;++nu)
+        for (int a=0;a<4;++a)
+        for (int b=0;b<4;++b) {
+            real s = d[a].G[mu][nu][b] - d[b].G[mu][nu][a];
+            s += g[mu][0][a]*g[0][nu][b] + g[mu][1][a]*g[1][nu][b] + g[mu][2][a]*g[2][nu][b] + g[mu][3][a]*g[3][nu][b];
+            s -= g[mu][0][b]*g[0][nu][a] + g[mu][1][b]*g[1][nu][a] + g[mu][2][b]*g[2][nu][a] + g[mu][3][b]*g[3][nu][a];
+            out[k].R[mu][nu][a][b] = s;
+        }
+    }
+}
+
+// T = Σ w_i E_i u_i⊗u_i (lowered) + (Σ w_i η m_i c²) g,  w_i = φσ(d̃²) with \tilde g = g²
+RSLM_BODY void stress_energy_body(const sym4& g, const Event* evs, std::size_t m, const vec4& x,
+                                  const TSParams& P, mat4& T) {
+    real gt[4][4];
+    for (int r=0;r<4;++r) for (int c=0;c<4;++c)
+        gt[r][c] = g.m[r][0]*g.m[0][c] + g.m[r][1]*g.m[1][c] + g.m[r][2]*g.m[2][c] + g.m[r][3]*g.m[3][c];
+    const real inv = real(0.5) / (P.sigma*P.sigma);
+
+    real S[4][4] = {};
+    real W = 0;
+    for (std::size_t i=0;i<m;++i) {
+        const Event& e = evs[i];
+        real d[4] = { x.v[0]-e.x.v[0], x.v[1]-e.x.v[1], x.v[2]-e.x.v[2], x.v[3]-e.x.v[3] };
+        real d2 = 0;
+        for (int r=0;r<4;++r) d2 += d[r] * (gt[r][0]*d[0] + gt[r][1]*d[1] + gt[r][2]*d[2] + gt[r][3]*d[3]);
+        real w = std::exp(-d2 * inv);
+        real ul[4];
+        for (int r=0;r<4;++r) ul[r] = g.m[r][0]*e.u.v[0] + g.m[r][1]*e.u.v[1] + g.m[r][2]*e.u.v[2] + g.m[r][3]*e.u.v[3];
+        real wE = w * e.E;
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) S[r][c] += wE * ul[r] * ul[c];
+        W += w * P.eta * e.m * P.c2;
+    }
+    for (int r=0;r<4;++r) for (int c=0;c<4;++c) T.m[r][c] = S[r][c] + W * g.m[r][c];
+}
+
+RSLM_BODY void palette_body(const real* v, std::size_t n, double vmin, double vmax, rslm::diag::RGB* out) {
+    const double s = (vmax > vmin) ? 1.0 / (vmax - vmin) : 0.0;
+    for (std::size_t k=0;k<n;++k) out[k] = rslm::diag::Thermal5::map((double(v[k]) - vmin) * s);
+}
+
+// ---- Variants ---------------------------------------------------------------------
+
+#define RSLM_DEFINE_VARIANT(ns, attr)                                                                 \
+    namespace ns {                                                                                    \
+    attr void mat4_mul(const mat4* A, const mat4* B, mat4* C, std::size_t n)                          \
+        { mat4_mul_body(A, B, C, n); }                                                                \
+    attr void inverse(const mat4* A, mat4* Ai, real* d, std::uint8_t* ok, std::size_t n, real eps)    \
+        { inverse_body(A, Ai, d, ok, n, eps); }                                                       \
+    attr void christoffel(const MetricPack* M, Gamma* out, std::size_t n)                             \
+        { christoffel_body(M, out, n); }                                                              \
+    attr void riemann(const Gamma* G, const Gamma* dG, Riemann* out, std::size_t n)                   \
+        { riemann_body(G, dG, out, n); }                                                              \
+    attr void stress_energy(const sym4& g, const Event* e, std::size_t m, const vec4& x,              \
+                            const TSParams& P, mat4& T)                                               \
+        { stress_energy_body(g, e, m, x, P, T); }                                                     \
+    attr void palette(const real* v, std::size_t n, double lo, double hi, rslm::diag::RGB* out)       \
+        { palette_body(v, n, lo, hi, out); }                                                          \
+    }
+
+RSLM_DEFINE_VARIANT(v_scalar, RSLM_TARGET_SCALAR)
+RSLM_DEFINE_VARIANT(v_baseline, )
+#if RSLM_HAVE_X86_VARIANTS
+RSLM_DEFINE_VARIANT(v_avx2, RSLM_TARGET_AVX2)
+RSLM_DEFINE_VARIANT(v_avx512, RSLM_TARGET_AVX512)
+#endif
+
+#define RSLM_TABLE(ns, label) \
+    Kernels{ label, &ns::mat4_mul, &ns::inverse, &ns::christoffel, &ns::riemann, &ns::stress_energy, &ns::palette }
+
+const Kernels kScalar   = RSLM_TABLE(v_scalar,   "scalar");
+const Kernels kBaseline = RSLM_TABLE(v_baseline, "baseline");
+#if RSLM_HAVE_X86_VARIANTS
+const Kernels kAvx2     = RSLM_TABLE(v_avx2,     "avx2");
+const Kernels kAvx512   = RSLM_TABLE(v_avx512,   "avx512");
+#endif
+
+std::vector<const Kernels*> detect() {
+    std::vector<const Kernels*> v{ &kScalar, &kBaseline };
+#if RSLM_HAVE_X86_VARIANTS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) v.push_back(&kAvx2);
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) v.push_back(&kAvx512);
+#endif
+    return v;
+}
+
+std::atomic<const Kernels*> g_active{nullptr};
+std::once_flag g_once;
+std::mutex g_calib_mtx;
+
+// ---- Benchmark helpers ------------------------------------------------------------
+
+template <typename Fn>
+double time_ns(Fn&& fn, int reps) {
+    double best = 1e300;
+    for (int r=0;r<std::max(1, reps);++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, double(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+    }
+    return best;
+}
+
+const Kernels* by_name(const std::vector<const Kernels*>& vars, const char* name) {
+    for (auto* K : vars) if (std::strcmp(K->name, name) == 0) return K;
+    return nullptr;
+}
+
+// Does table a run the same code as table b for `kernel`?
+bool same_kernel(const Kernels& a, const Kernels& b, const char* kernel) {
+    if (!std::strcmp(kernel, "mat4_mul"))         return a.mat4_mul == b.mat4_mul;
+    if (!std::strcmp(kernel, "inverse"))          return a.inverse == b.inverse;
+    if (!std::strcmp(kernel, "christoffel"))      return a.christoffel == b.christoffel;
+    if (!std::strcmp(kernel, "riemann_assemble")) return a.riemann_assemble == b.riemann_assemble;
+    if (!std::strcmp(kernel, "stress_energy"))    return a.stress_energy == b.stress_energy;
+    if (!std::strcmp(kernel, "palette_thermal5")) return a.palette_thermal5 == b.palette_thermal5;
+    return false;
+}
+
+// Times every available variant of every kernel (selected = false). Rows are
+// grouped by kernel, variants in available() order, scalar first.
+std::vector<BenchRow> measure(std::size_t n, int reps) {
+    n = std::max<std::size_t>(n, 16);
+    // Deterministic synthetic inputs: near-Minkowski metrics with small perturbations.
+    std::vector<mat4> A(n), B(n), C(n);
+    std::vector<real> det(n), vals(n);
+    std::vector<std::uint8_t> ok(n);
+    std::vector<MetricPack> M(n);
+    std::vector<Gamma> G(n), dG(4*n);
+    std::vector<Riemann> R(n);
+    std::vector<Event> evs(n);
+    std::vector<rslm::diag::RGB> rgb(n);
+    std::uint32_t s = 12345u;
+    auto rnd = [&] { s = s*1664525u + 1013904223u; return real(int(s >> 8) % 2001 - 1000) * real(1e-4); };
+    for (std::size_t k=0;k<n;++k) {
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) {
+            real eta = (r==c) ? (r==0 ? real(-1) : real(1)) : real(0);
+            A[k].m[r][c] = eta + rnd();
+            B[k].m[r][c] = eta + rnd();
+            M[k].g_inv.m[r][c] = eta + rnd();
+            for (int a=0;a<4;++a) M[k].dg.dg[a].m[r][c] = rnd();
+        }
+        for (int mu=0;mu<4;++mu) for (int a=0;a<4;++a) for (int b=0;b<4;++b) {
+            G[k].G[mu][a][b] = rnd();
+            for (int d=0;d<4;++d) dG[4*k+d].G[mu][a][b] = rnd();
+        }
+        evs[k].x = vec4{rnd()*real(1e4), rnd()*real(1e4), rnd()*real(1e4), rnd()*real(1e4)};
+        evs[k].u = vec4{real(1), rnd(), rnd(), rnd()};
+        vals[k] = rnd();
+    }
+    sym4 g0 = sym4(A[0]);
+    vec4 x0{};
+    TSParams P;
+    mat4 T;
+
+    const auto vars = detect();
+    std::vector<BenchRow> rows;
+    auto run = [&](const char* kernel, auto&& call) {
+        double base = 0;
+        for (auto* K : vars) {
+            double ns = time_ns([&] { call(*K); }, reps) / double(n);
+            if (K == &kScalar) base = ns;
+            rows.push_back(BenchRow{ kernel, K->name, ns, base > 0 ? base / ns : 1.0, false });
+        }
+    };
+    run("mat4_mul",         [&](const Kernels& K) { K.mat4_mul(A.data(), B.data(), C.data(), n); });
+    run("inverse",          [&](const Kernels& K) { K.inverse(A.data(), C.data(), det.data(), ok.data(), n, real(1e-14)); });
+    run("christoffel",      [&](const Kernels& K) { K.christoffel(M.data(), G.data(), n); });
+    run("riemann_assemble", [&](const Kernels& K) { K.riemann_assemble(G.data(), dG.data(), R.data(), n); });
+    run("stress_energy",    [&](const Kernels& K) { K.stress_energy(g0, evs.data(), n, x0, P, T); });
+    run("palette_thermal5", [&](const Kernels& K) { K.palette_thermal5(vals.data(), n, -0.1, 0.1, rgb.data()); });
+    return rows;
+}
+
+void mark_selected(std::vector<BenchRow>& rows, const Kernels& act) {
+    const auto vars = detect();
+    for (auto& r : rows) {
+        const Kernels* K = by_name(vars, r.variant);
+        r.selected = K && same_kernel(*K, act, r.kernel);
+    }
+}
+
+// Per-kernel table of the fastest measured variant (scalar unless another one
+// beats it). Tables are published by pointer and never freed (readers may
+// still hold an old one).
+const Kernels* build_table(const std::vector<BenchRow>& rows, const char* label) {
+    const auto vars = detect();
+    auto pick = [&](const char* kernel) -> const Kernels* {
+        double scalar_ns = 1e300;
+        for (const auto& r : rows)
+            if (!std::strcmp(r.kernel, kernel) && !std::strcmp(r.variant, kScalar.name)) scalar_ns = r.ns_per_item;
+        const Kernels* best = &kScalar;
+        double best_ns = scalar_ns;
+        for (const auto& r : rows) {
+            if (std::strcmp(r.kernel, kernel) != 0) continue;
+            const Kernels* K = by_name(vars, r.variant);
+            if (!K) continue;
+            if (r.ns_per_item < best_ns) { best = K; best_ns = r.ns_per_item; }
+        }
+        return best;
+    };
+    return new Kernels{ label,
+        pick("mat4_mul")->mat4_mul,
+        pick("inverse")->inverse,
+        pick("christoffel")->christoffel,
+        pick("riemann_assemble")->riemann_assemble,
+        pick("stress_energy")->stress_energy,
+        pick("palette_thermal5")->palette_thermal5 };
+}
+
+// RSLM_DISPATCH=<variant> forces it; =profile keeps the fastest per kernel.
+// Otherwise the widest variant the CPU supports: a feature check only, so the
+// choice (and every kern:: result) is the same on every run on this host.
+const Kernels* select_isa() {
+    auto v = detect();
+    if (const char* e = std::getenv("RSLM_DISPATCH")) {
+        if (const Kernels* K = by_name(v, e)) return K;
+        if (std::strcmp(e, "profile") == 0) return build_table(measure(1024, 3), "profiled");
+    }
+    return v.back();
+}
+
+} // namespace
+
+const Kernels& active() {
+    std::call_once(g_once, [] { g_active.store(select_isa(), std::memory_order_release); });
+    return *g_active.load(std::memory_order_acquire);
+}
+
+const Kernels& scalar() { return kScalar; }
+
+std::vector<const Kernels*> available() { return detect(); }
+
+std::vector<BenchRow> benchmark(std::size_t n, int reps) {
+    auto rows = measure(n, reps);
+    mark_selected(rows, active());
+    return rows;
+}
+
+std::vector<BenchRow> calibrate(std::size_t n, int reps) {
+    std::scoped_lock lk(g_calib_mtx);
+    active();                                   // settle first-use selection so it cannot overwrite ours
+    auto rows = measure(n, reps);
+    const Kernels* T = build_table(rows, "profiled");
+    g_active.store(T, std::memory_order_release);
+    mark_selected(rows, *T);
+    return rows;
+}
+
+void print_benchmark(std::FILE* f, const std::vector<BenchRow>& rows) {
+    std::fprintf(f, "dispatch: selected=%s real=%s\n", active().name, rslm::cfg::kRealName);
+    std::fprintf(f, "%-18s %-10s %12s %9s\n", "kernel", "variant", "ns/item", "speedup");
+    for (const auto& r : rows) {
+        const char* mark = r.selected ? " *" : "";
+        std::fprintf(f, "%-18s %-10s %12.2f %8.2fx%s\n", r.kernel, r.variant, r.ns_per_item, r.speedup, mark);
+    }
+}
+
+} // inline namespace RSLM_KERN_ABI
+} // namespace rslm::dispatch
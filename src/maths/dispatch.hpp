@@ -0,0 +1,85 @@
+#pragma once
+/**
+ * RSLM Maths — dispatch.hpp
+ * -------------------------
+ * Runtime-selected CPU variants of the hot batched kernels (compiled into
+ * rslm_maths, see dispatch.cpp). One source body per kernel is compiled
+ * several times with different target ISAs (without FMA contraction, so all
+ * variants agree bitwise). On first use we pick the widest ISA the running
+ * CPU supports; timing is opt-in: calibrate() times every variant and keeps
+ * the fastest one per kernel (wider vectors do not win for every AoS kernel).
+ * The compiled rslm::kern entry points (mul, christoffel, riemann_at,
+ * stress_energy_at) run through active().
+ *
+ *   variants: scalar   (auto-vectorization off; reference)
+ *             baseline (default ISA of the build: SSE2 / NEON)
+ *             avx2     (x86-64: AVX2 + FMA)
+ *             avx512   (x86-64: AVX-512F/DQ)
+ *
+ * RSLM_DISPATCH=<variant> forces one variant (ignored if unsupported);
+ * RSLM_DISPATCH=profile runs calibrate() on first use.
+ * benchmark() times every available variant against scalar.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "config.hpp"
+#include "types.hpp"
+#include "palette.hpp"
+
+namespace rslm::dispatch {
+inline namespace RSLM_KERN_ABI {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+using rslm::conn::Gamma;
+using rslm::conn::MetricPack;
+using rslm::curv::Riemann;
+using rslm::phys::Event;
+using rslm::phys::TSParams;
+
+struct Kernels {
+    const char* name;
+
+    // C[k] = A[k] B[k]
+    void (*mat4_mul)(const mat4* A, const mat4* B, mat4* C, std::size_t n);
+    // Cofactor inverse; ok[k] = |det| > eps (Ainv zeroed otherwise)
+    void (*inverse)(const mat4* A, mat4* Ainv, real* det, std::uint8_t* ok, std::size_t n, real eps);
+    // Γ from metric packs (g⁻¹ and ∂g)
+    void (*christoffel)(const MetricPack* M, Gamma* out, std::size_t n);
+    // R^μ_{ναβ} from Γ and dG[4k+a] = ∂_a Γ at lane k
+    void (*riemann_assemble)(const Gamma* G, const Gamma* dG, Riemann* out, std::size_t n);
+    // T_{μν}(x) accumulated over m events with local metric g = g(x)
+    void (*stress_energy)(const sym4& g, const Event* evs, std::size_t m, const vec4& x,
+                          const TSParams& P, mat4& T);
+    // Thermal5 palette over n values normalized to [vmin, vmax]
+    void (*palette_thermal5)(const real* v, std::size_t n, double vmin, double vmax, rslm::diag::RGB* out);
+};
+
+const Kernels& active();                       // current table (thread-safe)
+const Kernels& scalar();                       // reference variant
+std::vector<const Kernels*> available();       // all variants runnable on this CPU
+
+struct BenchRow {
+    const char* kernel;
+    const char* variant;
+    double ns_per_item;
+    double speedup;                            // vs scalar
+    bool selected;                             // variant used by active() for this kernel
+};
+
+std::vector<BenchRow> benchmark(std::size_t n = 4096, int reps = 5);
+
+// Profile-guided selection: time all variants, install the per-kernel fastest
+// as active(), and return the (re-marked) measurements. Safe to call at any
+// time, including before the first active().
+std::vector<BenchRow> calibrate(std::size_t n = 1024, int reps = 3);
+void print_benchmark(std::FILE* f, const std::vector<BenchRow>& rows);
+
+} // inline namespace RSLM_KERN_ABI
+} // namespace rslm::dispatch
@@ -89,4 +89,56 @@ inline bool jacobi_symmetric_4x4(const mat4& A_in, mat4& Q_out, rslm::linalg::ve
     return true;
 }
 
+// Modified Gram–Schmidt on the columns of Q (undoes rounding drift of a
+// frame that is carried across many calls).
+inline void orthonormalize_columns(mat4& Q) {
+    for (int j=0;j<4;++j) {
+        for (int i=0;i<j;++i) {
+            real d = 0;
+            for (int k=0;k<4;++k) d += Q.m[k][i] * Q.m[k][j];
+            for (int k=0;k<4;++k) Q.m[k][j] -= d * Q.m[k][i];
+        }
+        real n = 0;
+        for (int k=0;k<4;++k) n += Q.m[k][j] * Q.m[k][j];
+        n = std::sqrt(n);
+        if (!(n > real(1e-30))) { Q = rslm::linalg::identity(); return; }   // degenerate frame: restart
+        for (int k=0;k<4;++k) Q.m[k][j] /= n;
+    }
+}
+
+/**
+ * Warm-started Jacobi: reuse a previous eigenframe Q_io as the initial guess.
+ * Q_io is re-orthonormalized, A is rotated into that frame (A' = Qᵀ A Q) and
+ * only the residual off-diagonals are cleaned up, so slowly varying metrics
+ * (e.g. along a trajectory) converge in a handful of rotations.
+ * If max_rotations is not enough, the cold solve is run instead, so the result
+ * is never less converged than jacobi_symmetric_4x4.
+ * @param Q_io      in: previous frame, out: refined eigenvectors
+ * @param cold_out  optional: set to true when the cold fallback ran
+ * @returns number of warm rotations applied
+ */
+inline int jacobi_symmetric_4x4_warm(const mat4& A_in, mat4& Q_io, rslm::linalg::vec4& lam,
+                                     int max_rotations = 16, real tol = real(1e-12), bool* cold_out = nullptr) {
+    orthonormalize_columns(Q_io);
+    mat4 A = rslm::linalg::mul(rslm::linalg::mul(rslm::linalg::transpose(Q_io), A_in), Q_io);
+
+    int rot = 0;
+    bool converged = false;
+    for (;; ++rot) {
+        int p, q; real off;
+        max_offdiag_abs(A, p, q, off);
+        if (off < tol) { converged = true; break; }
+        if (rot == max_rotations) break;
+        jacobi_rotate(A, Q_io, p, q);
+    }
+    if (cold_out) *cold_out = !converged;
+    if (!converged) {
+        jacobi_symmetric_4x4(A_in, Q_io, lam, 32, tol);
+        return rot;
+    }
+
+    for (int i=0;i<4;++i) lam.v[i] = A.m[i][i];
+    return rot;
+}
+
 } // namespace rslm::eigen
@@ -4,9 +4,18 @@
  * ----------------------
  * Metric-field and potential-field interfaces + a couple of baseline fields.
  * The metric interface returns a symmetric 4×4 metric g_{μν}(x).
+ *
+ * The geometry kernels (dmetric, prepare_metric, riemann_at, geodesic_step,
+ * samplers) are templates over the field type: passed a concrete (final or
+ * non-virtual) field they call its g()/V() directly, so the stencils inline
+ * and vectorize; passed an IMetricField& they go through the vtable as before.
  */
 
+#include <concepts>
+#include <utility>
+
 #include "config.hpp"
+#include "types.hpp"
 #include "linalg.hpp"
 #include "metric.hpp"
 #include "trace.hpp"
@@ -19,14 +28,33 @@ using rslm::linalg::mat4;
 using rslm::linalg::sym4;
 
 // ---------------- Interfaces ----------------
-struct IMetricField {
-    virtual ~IMetricField() = default;
-    virtual sym4 g(const vec4& x) const = 0;
+// IMetricField / IPotential are declared in types.hpp.
+
+// Anything with g(x) -> sym4 (IMetricField included).
+template <typename Fd>
+concept MetricFieldLike = requires(const Fd& f, const vec4& x) {
+    { f.g(x) } -> std::convertible_to<sym4>;
+};
+
+// Anything with V(x) -> real (IPotential included).
+template <typename Pt>
+concept PotentialLike = requires(const Pt& p, const vec4& x) {
+    { p.V(x) } -> std::convertible_to<real>;
+};
+
+// Adapters: hand a non-virtual field/potential to an API that takes the interface.
+template <MetricFieldLike Fd>
+struct VirtualMetricField final : IMetricField {
+    Fd f;
+    explicit VirtualMetricField(Fd f_) : f(std::move(f_)) {}
+    sym4 g(const vec4& x) const override { return f.g(x); }
 };
 
-struct IPotential {
-    virtual ~IPotential() = default;
-    virtual real V(const vec4& x) const = 0;            // scalar potential
+template <PotentialLike Pt>
+struct VirtualPotential final : IPotential {
+    Pt p;
+    explicit VirtualPotential(Pt p_) : p(std::move(p_)) {}
+    real V(const vec4& x) const override { return p.V(x); }
 };
 
 // --------------- Baseline fields ------------
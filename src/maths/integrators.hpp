@@ -6,6 +6,8 @@
  * We expose a velocity-Verlet–like step that keeps good energy behavior.
  */
 
+#include <cstddef>
+
 #include "config.hpp"
 #include "linalg.hpp"
 #include "connection.hpp"
@@ -13,6 +15,7 @@
 #include "field.hpp"
 #include "quadform.hpp"
 #include "units.hpp"
+#include "parallel.hpp"
 #include "trace.hpp"
 
 namespace rslm::integ {
@@ -23,9 +26,12 @@ using rslm::conn::MetricPack;
 using rslm::conn::Gamma;
 using rslm::field::IMetricField;
 using rslm::field::IPotential;
+using rslm::field::MetricFieldLike;
+using rslm::field::PotentialLike;
 
 // Acceleration a^μ = - Γ^μ_{αβ} u^α u^β  +  f^μ, with f^μ = - g^{μν} ∂_ν V
-inline vec4 accel(const MetricPack& M, const Gamma& G, const vec4& u, const IPotential* P, const vec4& x) {
+template <PotentialLike Pt = IPotential>
+inline vec4 accel(const MetricPack& M, const Gamma& G, const vec4& u, const Pt* P, const vec4& x) {
     vec4 a{0,0,0,0};
     // - Γ term
     for (int mu=0; mu<4; ++mu) {
@@ -55,8 +61,10 @@ inline void renormalize_timelike(const rslm::linalg::mat4& g, vec4& u) {
 }
 
 // Velocity-Verlet style step (geometric-ish), small dtau advised.
-inline void geodesic_step(const IMetricField& F, const IPotential* P,
-                          vec4& x, vec4& u, real dtau) {
+// renormalize=false keeps g(u,u) free (exp-map / spacelike use).
+template <MetricFieldLike Fd, PotentialLike Pt>
+inline void geodesic_step(const Fd& F, const Pt* P,
+                          vec4& x, vec4& u, real dtau, bool renormalize = true) {
     MetricPack M = rslm::conn::prepare_metric(F, x);
     Gamma G = rslm::conn::christoffel(M);
 
@@ -78,10 +86,18 @@ inline void geodesic_step(const IMetricField& F, const IPotential* P,
     for (int i=0;i<4;++i) u.v[i] = uh.v[i] + real(0.5) * dtau * a1.v[i];
 
     // keep timelike normalization (for stability)
-    renormalize_timelike(M1.g, u);
+    if (renormalize) renormalize_timelike(M1.g, u);
+}
+
+// No forcing: geodesic_step(F, nullptr, ...)
+template <MetricFieldLike Fd>
+inline void geodesic_step(const Fd& F, std::nullptr_t,
+                          vec4& x, vec4& u, real dtau, bool renormalize = true) {
+    geodesic_step(F, static_cast<const IPotential*>(nullptr), x, u, dtau, renormalize);
 }
 
-inline void rk4_geodesic(const rslm::field::IMetricField& F,
+template <MetricFieldLike Fd>
+inline void rk4_geodesic(const Fd& F,
                          rslm::linalg::vec4& x,
                          rslm::linalg::vec4& u,
                          rslm::cfg::real dtau,
@@ -90,4 +106,21 @@ inline void rk4_geodesic(const rslm::field::IMetricField& F,
     geodesic_step(F, P, x, u, dtau);
 }
 
+// Advance n independent trajectories by one step each (in place, threaded).
+template <MetricFieldLike Fd, PotentialLike Pt>
+inline void geodesic_step_batch(const Fd& F, const Pt* P,
+                                vec4* x, vec4* u, std::size_t n, real dtau,
+                                unsigned threads = 0) {
+    rslm::par::parallel_for(n, [&](std::size_t b, std::size_t e) {
+        for (std::size_t k=b;k<e;++k) geodesic_step(F, P, x[k], u[k], dtau);
+    }, threads, 16);
+}
+
+template <MetricFieldLike Fd>
+inline void geodesic_step_batch(const Fd& F, std::nullptr_t,
+                                vec4* x, vec4* u, std::size_t n, real dtau,
+                                unsigned threads = 0) {
+    geodesic_step_batch(F, static_cast<const IPotential*>(nullptr), x, u, n, dtau, threads);
+}
+
 } // namespace rslm::integ
@@ -0,0 +1,93 @@
+#include "kernels.hpp"
+
+#include "linalg.hpp"
+#include "connection.hpp"
+#include "curvature.hpp"
+#include "integrators.hpp"
+#include "grid.hpp"
+#include "slicer.hpp"
+#include "stress_energy.hpp"
+#include "einstein_fit.hpp"
+#include "dispatch.hpp"
+
+namespace rslm::kern {
+inline namespace RSLM_KERN_ABI {
+
+mat4 mul(const mat4& A, const mat4& B) {
+    mat4 C;
+    rslm::dispatch::active().mat4_mul(&A, &B, &C, 1);
+    return C;
+}
+
+bool inverse(const mat4& A, mat4& Ainv, real& out_det, real& out_cond_inf, real eps) {
+    return rslm::linalg::inverse(A, Ainv, out_det, out_cond_inf, eps);
+}
+
+MetricPack prepare_metric(const IMetricField& F, const vec4& x) { return rslm::conn::prepare_metric(F, x); }
+Gamma christoffel(const MetricPack& M) {
+    Gamma G;
+    rslm::dispatch::active().christoffel(&M, &G, 1);
+    return G;
+}
+
+// Same scheme as curv::riemann_at: Γ at x and ∂_a Γ by central differences of Γ(x ± h e_a)
+Riemann riemann_at(const IMetricField& F, const vec4& x) {
+    const auto& K = rslm::dispatch::active();
+    const real h = rslm::units::C().fd_h;
+    MetricPack M[9];
+    M[8] = rslm::conn::prepare_metric(F, x);
+    for (int a=0;a<4;++a) {
+        vec4 xp = x, xm = x; xp.v[a] += h; xm.v[a] -= h;
+        M[2*a]   = rslm::conn::prepare_metric(F, xp);
+        M[2*a+1] = rslm::conn::prepare_metric(F, xm);
+    }
+    Gamma G[9], dG[4];
+    K.christoffel(M, G, 9);
+    const real s = real(0.5) / h;
+    for (int a=0;a<4;++a)
+        for (int mu=0;mu<4;++mu) for (int nu=0;nu<4;++nu) for (int b=0;b<4;++b)
+            dG[a].G[mu][nu][b] = (G[2*a].G[mu][nu][b] - G[2*a+1].G[mu][nu][b]) * s;
+    Riemann R;
+    K.riemann_assemble(&G[8], dG, &R, 1);
+    return R;
+}
+
+Riemann    riemann_at_stencil(const IMetricField& F, const vec4& x) { return rslm::curv::riemann_at_stencil(F, x); }
+mat4       ricci(const Riemann& R)                              { return rslm::curv::ricci(R); }
+real       curv_scalar(const IMetricField& F, const vec4& x)    { return rslm::diag::curv_scalar(F, x); }
+real       curv_riemann_frob(const IMetricField& F, const vec4& x) { return rslm::diag::curv_riemann_frob(F, x); }
+
+void geodesic_step(const IMetricField& F, const IPotential* P,
+                   vec4& x, vec4& u, real dtau, bool renormalize) {
+    rslm::integ::geodesic_step(F, P, x, u, dtau, renormalize);
+}
+
+void geodesic_step_batch(const IMetricField& F, const IPotential* P,
+                         vec4* x, vec4* u, std::size_t n, real dtau, unsigned threads) {
+    rslm::integ::geodesic_step_batch(F, P, x, u, n, dtau, threads);
+}
+
+mat4 stress_energy_at(const IMetricField& F, const std::vector<Event>& evs,
+                      const vec4& x, const TSParams& P) {
+    mat4 T;
+    rslm::dispatch::active().stress_energy(F.g(x), evs.data(), evs.size(), x, P, T);
+    return T;
+}
+
+sym4 einstein_at(const IMetricField& F, const vec4& x) { return rslm::phys::einstein_at(F, x); }
+
+real residual_norm(const IMetricField& F, const std::vector<Event>& evs,
+                   const vec4& x, const TSParams& P) {
+    return rslm::phys::residual_norm(F, evs, x, P);
+}
+
+} // inline namespace RSLM_KERN_ABI
+} // namespace rslm::kern
+
+// ---- Explicit instantiations (see RSLM_PRECOMPILED in grid.hpp / slicer.hpp) ---
+namespace rslm::diag {
+template Grid2D sample_xy<ScalarFnPtr, IMetricField>(const IMetricField&, real, real, real, real, real, real,
+                                                     std::size_t, std::size_t, ScalarFnPtr);
+template Grid2D sample_plane<ScalarFnPtr, IMetricField>(const IMetricField&, int, int, const std::array<real,4>&,
+                                                        real, real, real, real, std::size_t, std::size_t, ScalarFnPtr);
+} // namespace rslm::diag
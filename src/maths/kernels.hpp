@@ -0,0 +1,67 @@
+#pragma once
+/**
+ * RSLM Maths — kernels.hpp
+ * ------------------------
+ * Lean public header for the hot kernels of the precompiled `rslm_maths`
+ * library. It only depends on types.hpp (no telemetry, iostreams or
+ * <filesystem>), so large code bases can include it from every TU and
+ * link the kernels once instead of re-instantiating the header-only API.
+ *
+ * The functions forward to the header implementations; they are compiled
+ * once in kernels.cpp, where LTO/PGO settings apply. mul, christoffel,
+ * riemann_at and stress_energy_at run the runtime-selected variant
+ * (dispatch.hpp) and agree with the headers to rounding; inverse keeps the
+ * pivoted Gauss–Jordan path, which also reports the condition number.
+ * The inline namespace encodes the `real` type so float and double builds of
+ * the library cannot be mixed up at link time.
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "config.hpp"
+#include "types.hpp"
+
+namespace rslm::kern {
+inline namespace RSLM_KERN_ABI {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+using rslm::field::IMetricField;
+using rslm::field::IPotential;
+using rslm::conn::Gamma;
+using rslm::conn::MetricPack;
+using rslm::curv::Riemann;
+using rslm::phys::Event;
+using rslm::phys::TSParams;
+
+// ---- Algebra ------------------------------------------------------------------
+mat4 mul(const mat4& A, const mat4& B);
+bool inverse(const mat4& A, mat4& Ainv, real& out_det, real& out_cond_inf, real eps = real(1e-14));
+
+// ---- Geometry -----------------------------------------------------------------
+MetricPack prepare_metric(const IMetricField& F, const vec4& x);
+Gamma      christoffel(const MetricPack& M);
+Riemann    riemann_at(const IMetricField& F, const vec4& x);
+Riemann    riemann_at_stencil(const IMetricField& F, const vec4& x);   // 33-point jet, FD-close to riemann_at
+mat4       ricci(const Riemann& R);
+real       curv_scalar(const IMetricField& F, const vec4& x);
+real       curv_riemann_frob(const IMetricField& F, const vec4& x);
+
+// ---- Integration --------------------------------------------------------------
+void geodesic_step(const IMetricField& F, const IPotential* P,
+                   vec4& x, vec4& u, real dtau, bool renormalize = true);
+void geodesic_step_batch(const IMetricField& F, const IPotential* P,
+                         vec4* x, vec4* u, std::size_t n, real dtau, unsigned threads = 0);
+
+// ---- Physics ------------------------------------------------------------------
+mat4 stress_energy_at(const IMetricField& F, const std::vector<Event>& evs,
+                      const vec4& x, const TSParams& P);
+sym4 einstein_at(const IMetricField& F, const vec4& x);
+real residual_norm(const IMetricField& F, const std::vector<Event>& evs,
+                   const vec4& x, const TSParams& P);
+
+} // inline namespace RSLM_KERN_ABI
+} // namespace rslm::kern
@@ -0,0 +1,204 @@
+#pragma once
+/**
+ * RSLM Maths — lattice_field.hpp
+ * ------------------------------
+ * Static metric parameterized on a 3D node lattice:
+ *
+ *   g(x) = η + Σ_n B(x - x_n) c_n        (uniform cubic B-spline, C² in x,y,z)
+ *
+ * Coefficients c_n are symmetric 4×4, kept SoA in a Sym4Batch (10 packed
+ * components per node, node index n = (k·ny + j)·nx + i). The metric ignores
+ * t, and node indices are clamped at the faces (edge coefficients extend
+ * outward). g is not projected onto Lorentzian signature; keep |c| small
+ * relative to η or check with metric::project_signature downstream.
+ *
+ *  - g(x), g_batch       : IMetricField interface (final, so templated
+ *                          kernels inline it)
+ *  - jet(x, g, dg, ddg)  : closed-form g, ∂g, ∂∂g (∂_t terms are zero), the
+ *                          input of curv::riemann_from_jet; also the
+ *                          metric_jet hook, so deriv::metric_jet and
+ *                          riemann_at_stencil use it
+ *  - stencil(x, ...)     : the ≤ 64 nodes touching x with their value / first /
+ *                          second-derivative weights (used by fitters)
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include "config.hpp"
+#include "types.hpp"
+#include "linalg.hpp"
+#include "linalg_batch.hpp"
+#include "deriv.hpp"
+
+namespace rslm::field {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+using rslm::linalg::Sym4Batch;
+using rslm::linalg::sym_idx;
+
+// Node weights for one point: w[q] for value, d1[q][a] = ∂_a, d2[q][p] = ∂_a∂_b
+// with p over (xx, xy, xz, yy, yz, zz); a ∈ {x, y, z}.
+struct SplineStencil {
+    std::size_t node[64];
+    real w[64];
+    real d1[64][3];
+    real d2[64][6];
+};
+
+// Spatial pair index p ↔ (a, b), a ≤ b over {x, y, z}
+inline constexpr int kPairA[6] = {0, 0, 0, 1, 1, 2};
+inline constexpr int kPairB[6] = {0, 1, 2, 1, 2, 2};
+
+class LatticeMetricField final : public IMetricField {
+public:
+    LatticeMetricField() = default;
+
+    LatticeMetricField(std::size_t nx, std::size_t ny, std::size_t nz, real x0, real y0, real z0, real h)
+        : nx_(nx), ny_(ny), nz_(nz), x0_(x0), y0_(y0), z0_(z0), h_(h) { c_.resize(nx*ny*nz); }
+
+    std::size_t nx() const { return nx_; }
+    std::size_t ny() const { return ny_; }
+    std::size_t nz() const { return nz_; }
+    std::size_t nodes() const { return c_.n; }
+    real h() const { return h_; }
+    vec4 node_pos(std::size_t n) const {
+        std::size_t i = n % nx_, j = (n / nx_) % ny_, k = n / (nx_*ny_);
+        return vec4(0, x0_ + real(i)*h_, y0_ + real(j)*h_, z0_ + real(k)*h_);
+    }
+
+    Sym4Batch&       coeffs()       { return c_; }
+    const Sym4Batch& coeffs() const { return c_; }
+
+    sym4 g(const vec4& x) const override {
+        real fw[3][4], fd[3][4], fdd[3][4];
+        std::size_t idx[3][4];
+        basis(x, idx, fw, fd, fdd);
+        real acc[10] = {};
+        for (int kz=0;kz<4;++kz)
+            for (int ky=0;ky<4;++ky) {
+                const real wyz = fw[1][ky] * fw[2][kz];
+                const std::size_t row = (idx[2][kz]*ny_ + idx[1][ky])*nx_;
+                for (int kx=0;kx<4;++kx) {
+                    const real w = fw[0][kx] * wyz;
+                    const std::size_t n = row + idx[0][kx];
+                    for (int p=0;p<10;++p) acc[p] += w * c_.c[p][n];
+                }
+            }
+        return assemble(acc);
+    }
+
+    void g_batch(const vec4* xs, sym4* out, std::size_t n) const override {
+        for (std::size_t k=0;k<n;++k) out[k] = g(xs[k]);
+    }
+
+    // Node weights of x (value, ∂, ∂∂) — 64 entries, clamped nodes may repeat.
+    void stencil(const vec4& x, SplineStencil& S) const {
+        real fw[3][4], fd[3][4], fdd[3][4];
+        std::size_t idx[3][4];
+        basis(x, idx, fw, fd, fdd);
+        const real ih = real(1) / h_, ih2 = ih * ih;
+        int q = 0;
+        for (int kz=0;kz<4;++kz)
+            for (int ky=0;ky<4;++ky)
+                for (int kx=0;kx<4;++kx, ++q) {
+                    const int o[3] = {kx, ky, kz};
+                    S.node[q] = (idx[2][kz]*ny_ + idx[1][ky])*nx_ + idx[0][kx];
+                    S.w[q] = fw[0][kx] * fw[1][ky] * fw[2][kz];
+                    for (int a=0;a<3;++a) {
+                        real v = ih;
+                        for (int d=0;d<3;++d) v *= (d == a) ? fd[d][o[d]] : fw[d][o[d]];
+                        S.d1[q][a] = v;
+                    }
+                    for (int p=0;p<6;++p) {
+                        const int a = kPairA[p], b = kPairB[p];
+                        real v = ih2;
+                        for (int d=0;d<3;++d) {
+                            if (a == b) v *= (d == a) ? fdd[d][o[d]] : fw[d][o[d]];
+                            else        v *= (d == a || d == b) ? fd[d][o[d]] : fw[d][o[d]];
+                        }
+                        S.d2[q][p] = v;
+                    }
+                }
+    }
+
+    // Closed-form g, ∂g, ∂∂g at x (time derivatives are zero).
+    void jet(const vec4& x, sym4& g, rslm::deriv::DMetric4& dg, rslm::deriv::DDMetric4& ddg) const {
+        SplineStencil S;
+        stencil(x, S);
+        real v[10] = {}, d1[3][10] = {}, d2[6][10] = {};
+        for (int q=0;q<64;++q) {
+            const std::size_t n = S.node[q];
+            for (int p=0;p<10;++p) {
+                const real c = c_.c[p][n];
+                v[p] += S.w[q] * c;
+                for (int a=0;a<3;++a) d1[a][p] += S.d1[q][a] * c;
+                for (int r=0;r<6;++r) d2[r][p] += S.d2[q][r] * c;
+            }
+        }
+        g = assemble(v);
+        for (int a=0;a<4;++a) dg.dg[a] = mat4{};
+        for (int a=0;a<4;++a) for (int b=0;b<4;++b) ddg.ddg[a][b] = mat4{};
+        for (int a=0;a<3;++a) dg.dg[a+1] = unpack10(d1[a]);
+        for (int r=0;r<6;++r) {
+            mat4 M = unpack10(d2[r]);
+            ddg.ddg[kPairA[r]+1][kPairB[r]+1] = M;
+            ddg.ddg[kPairB[r]+1][kPairA[r]+1] = M;
+        }
+    }
+
+    // Exact jet, so the difference step is unused.
+    bool metric_jet(const vec4& x, sym4& g, rslm::deriv::DMetric4& dg, rslm::deriv::DDMetric4& ddg,
+                    real) const override {
+        jet(x, g, dg, ddg);
+        return true;
+    }
+
+private:
+    // Uniform cubic B-spline weights (and derivatives in cell units) per axis
+    void basis(const vec4& x, std::size_t idx[3][4], real fw[3][4], real fd[3][4], real fdd[3][4]) const {
+        const real o[3] = {x0_, y0_, z0_};
+        const std::size_t n[3] = {nx_, ny_, nz_};
+        for (int d=0; d<3; ++d) {
+            real f = (x.v[d+1] - o[d]) / h_;
+            real fl = std::floor(f), t = f - fl;
+            long c = long(fl);
+            real t2 = t*t, t3 = t2*t, u = 1 - t;
+            fw[d][0] = u*u*u / 6;
+            fw[d][1] = (3*t3 - 6*t2 + 4) / 6;
+            fw[d][2] = (-3*t3 + 3*t2 + 3*t + 1) / 6;
+            fw[d][3] = t3 / 6;
+            fd[d][0] = -u*u / 2;
+            fd[d][1] = (3*t2 - 4*t) / 2;
+            fd[d][2] = (-3*t2 + 2*t + 1) / 2;
+            fd[d][3] = t2 / 2;
+            fdd[d][0] = u;
+            fdd[d][1] = 3*t - 2;
+            fdd[d][2] = -3*t + 1;
+            fdd[d][3] = t;
+            for (int q=0;q<4;++q) idx[d][q] = std::size_t(std::clamp(c - 1 + q, 0L, long(n[d]) - 1));
+        }
+    }
+
+    static mat4 unpack10(const real* a) {
+        mat4 M;
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) M.m[r][c] = a[sym_idx(r,c)];
+        return M;
+    }
+
+    static sym4 assemble(const real* acc) {
+        sym4 g = rslm::linalg::minkowski_eta();
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) g.m[r][c] += acc[sym_idx(r,c)];
+        return g;
+    }
+
+    std::size_t nx_{0}, ny_{0}, nz_{0};
+    real x0_{0}, y0_{0}, z0_{0}, h_{1};
+    Sym4Batch c_;
+};
+
+} // namespace rslm::field
@@ -6,6 +6,7 @@
  *   - vec4  : 4-vector (contravariant or covariant, depending on use)
  *   - mat4  : 4×4 matrix, row-major
  *   - sym4  : 4×4 symmetric matrix (constructed by symmetrization)
+ *   (the structs themselves live in types.hpp)
  *
  * Operations:
  *   - identity(), diag(a0,a1,a2,a3)
@@ -29,6 +30,7 @@
 #include <algorithm>
 
 #include "config.hpp"
+#include "types.hpp"
 #include "trace.hpp"
 
 namespace rslm::linalg {
@@ -52,22 +54,7 @@ struct Throttle {
     bool tick() { ++n; return (n <= first) || (stride && (n % stride == 0)); }
 };
 
-// ----------------------------------------------------------------------------
-// vec4
-// ----------------------------------------------------------------------------
-struct vec4 {
-    std::array<real,4> v{real(0),real(0),real(0),real(0)};
-
-    vec4() = default;
-    vec4(real t, real x, real y, real z) { v[0]=t; v[1]=x; v[2]=y; v[3]=z; }
-    explicit vec4(std::initializer_list<real> a) {
-        std::size_t i=0; for (real e : a) { if (i<4) v[i++]=e; }
-        for (; i<4; ++i) v[i]=real(0);
-    }
-
-    real& operator[](std::size_t i)       { return v[i]; }
-    const real& operator[](std::size_t i) const { return v[i]; }
-};
+// vec4 / mat4 / sym4 are defined in types.hpp
 
 // Stream pretty-printer (compact)
 inline std::ostream& operator<<(std::ostream& os, const vec4& a) {
@@ -77,32 +64,6 @@ inline std::ostream& operator<<(std::ostream& os, const vec4& a) {
     return os;
 }
 
-// ----------------------------------------------------------------------------
-// mat4 (row-major)
-// ----------------------------------------------------------------------------
-struct mat4 {
-    // m[r][c]
-    std::array<std::array<real,4>,4> m{{
-        {{real(0),real(0),real(0),real(0)}},
-        {{real(0),real(0),real(0),real(0)}},
-        {{real(0),real(0),real(0),real(0)}},
-        {{real(0),real(0),real(0),real(0)}},
-    }};
-
-    mat4() = default;
-    explicit mat4(real s) {
-        for (int r=0;r<4;++r) for (int c=0;c<4;++c) m[r][c]=(r==c)?s:real(0);
-    }
-    explicit mat4(std::initializer_list<real> a) {
-        int k=0;
-        for (real e : a) { m[k/4][k%4]=e; if (++k==16) break; }
-        for (;k<16;++k) m[k/4][k%4]=real(0);
-    }
-
-    real*       operator[](std::size_t r)       { return m[r].data(); }
-    const real* operator[](std::size_t r) const { return m[r].data(); }
-};
-
 inline std::ostream& operator<<(std::ostream& os, const mat4& A) {
     os.setf(std::ios::fixed, std::ios::floatfield);
     os << "[";
@@ -118,21 +79,6 @@ inline std::ostream& operator<<(std::ostream& os, const mat4& A) {
     return os;
 }
 
-// Symmetric wrapper: builds 0.5*(M + M^T)
-struct sym4 : mat4 {
-    sym4() = default;
-    explicit sym4(const mat4& A) {
-        for (int r=0;r<4;++r) for (int c=0;c<4;++c) {
-            m[r][c] = real(0.5)*(A.m[r][c] + A.m[c][r]);
-        }
-    }
-    static sym4 from_diag(real a0, real a1, real a2, real a3) {
-        sym4 S; for (int i=0;i<4;++i) for (int j=0;j<4;++j) S.m[i][j]=real(0);
-        S.m[0][0]=a0; S.m[1][1]=a1; S.m[2][2]=a2; S.m[3][3]=a3;
-        return S;
-    }
-};
-
 // ----------------------------------------------------------------------------
 // Constructors/utilities
 // ----------------------------------------------------------------------------
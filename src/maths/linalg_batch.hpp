@@ -0,0 +1,162 @@
+#pragma once
+/**
+ * RSLM Maths — linalg_batch.hpp
+ * -----------------------------
+ * Structure-of-arrays (SoA) containers for batched 4D algebra:
+ *   - Sym4Batch : n symmetric 4×4 matrices, 10 packed components per lane
+ *                 (also used for lower-triangular factors L, same packing)
+ *   - Vec4Batch : n 4-vectors, one array per component
+ *   - sym4_inverse_batch : branch-free cofactor det/inverse across lanes with
+ *                          a cheap relative conditioning flag
+ *
+ * Packing order of the 10 components (upper triangle, row by row):
+ *   00 01 02 03 11 12 13 22 23 33      → sym_idx(r,c) == sym_idx(c,r)
+ *
+ * Lane loops over these arrays are plain contiguous streams, which is what
+ * lets the batched kernels vectorize across matrices instead of inside one.
+ */
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+#include "config.hpp"
+#include "linalg.hpp"
+
+namespace rslm::linalg {
+
+using rslm::cfg::real;
+
+inline constexpr int sym_idx(int r, int c) {
+    constexpr int tbl[4][4] = {{0,1,2,3},{1,4,5,6},{2,5,7,8},{3,6,8,9}};
+    return tbl[r][c];
+}
+
+struct Sym4Batch {
+    std::size_t n{0};
+    std::array<std::vector<real>,10> c;
+
+    inline void resize(std::size_t n_) { n = n_; for (auto& v : c) v.assign(n_, real(0)); }
+
+    inline real*       comp(int r, int col)       { return c[sym_idx(r,col)].data(); }
+    inline const real* comp(int r, int col) const { return c[sym_idx(r,col)].data(); }
+
+    // Stores the upper triangle of A (A is assumed symmetric).
+    inline void set(std::size_t k, const mat4& A) {
+        for (int r=0;r<4;++r) for (int col=r;col<4;++col) c[sym_idx(r,col)][k] = A.m[r][col];
+    }
+    inline sym4 get(std::size_t k) const {
+        sym4 S;
+        for (int r=0;r<4;++r) for (int col=0;col<4;++col) S.m[r][col] = c[sym_idx(r,col)][k];
+        return S;
+    }
+    // Lower-triangular view (for Cholesky factors): zeros above the diagonal.
+    inline mat4 get_lower(std::size_t k) const {
+        mat4 L;
+        for (int r=0;r<4;++r) for (int col=0;col<=r;++col) L.m[r][col] = c[sym_idx(r,col)][k];
+        return L;
+    }
+};
+
+struct Vec4Batch {
+    std::size_t n{0};
+    std::array<std::vector<real>,4> c;
+
+    inline void resize(std::size_t n_) { n = n_; for (auto& v : c) v.assign(n_, real(0)); }
+
+    inline void set(std::size_t k, const vec4& x) { for (int i=0;i<4;++i) c[i][k] = x.v[i]; }
+    inline vec4 get(std::size_t k) const { return vec4{c[0][k], c[1][k], c[2][k], c[3][k]}; }
+};
+
+// AoS → SoA
+inline void pack(const mat4* A, std::size_t n, Sym4Batch& out) {
+    out.resize(n);
+    for (std::size_t k=0;k<n;++k) out.set(k, A[k]);
+}
+inline void pack(const vec4* x, std::size_t n, Vec4Batch& out) {
+    out.resize(n);
+    for (std::size_t k=0;k<n;++k) out.set(k, x[k]);
+}
+
+// SoA → AoS
+inline void unpack(const Sym4Batch& B, sym4* out) {
+    for (std::size_t k=0;k<B.n;++k) out[k] = B.get(k);
+}
+inline void unpack(const Vec4Batch& B, vec4* out) {
+    for (std::size_t k=0;k<B.n;++k) out[k] = B.get(k);
+}
+
+// ---- Batched symmetric inverse ---------------------------------------------------
+
+struct Sym4InvReport {
+    std::vector<real> det;
+    std::vector<std::uint8_t> ok;   // 1 if |det| > eps · max|a_ij|⁴ (and finite)
+    std::size_t n_ok{0};
+
+    inline void resize(std::size_t n) { det.assign(n, real(0)); ok.assign(n, 0); }
+};
+
+/**
+ * Ainv = A⁻¹ lane by lane via 2×2-minor cofactor expansion (no pivoting, no
+ * branches), computing only the 10 independent entries of the symmetric inverse.
+ * The flag is scale-free: |det| relative to the largest entry to the 4th power,
+ * so η-like metrics pass at any units. Flagged lanes get Ainv = 0 (finite).
+ */
+inline void sym4_inverse_batch(const Sym4Batch& A, Sym4Batch& Ainv, Sym4InvReport& R,
+                               real eps = real(1e-14))
+{
+    const std::size_t n = A.n;
+    Ainv.resize(n);
+    R.resize(n);
+    const real *p00=A.comp(0,0), *p01=A.comp(0,1), *p02=A.comp(0,2), *p03=A.comp(0,3),
+               *p11=A.comp(1,1), *p12=A.comp(1,2), *p13=A.comp(1,3),
+               *p22=A.comp(2,2), *p23=A.comp(2,3), *p33=A.comp(3,3);
+    real *q00=Ainv.comp(0,0), *q01=Ainv.comp(0,1), *q02=Ainv.comp(0,2), *q03=Ainv.comp(0,3),
+         *q11=Ainv.comp(1,1), *q12=Ainv.comp(1,2), *q13=Ainv.comp(1,3),
+         *q22=Ainv.comp(2,2), *q23=Ainv.comp(2,3), *q33=Ainv.comp(3,3);
+    real* dt = R.det.data();
+    std::uint8_t* ok = R.ok.data();
+
+    RSLM_VECTORIZE
+    for (std::size_t k=0;k<n;++k) {
+        const real a00=p00[k], a01=p01[k], a02=p02[k], a03=p03[k],
+                   a11=p11[k], a12=p12[k], a13=p13[k],
+                   a22=p22[k], a23=p23[k], a33=p33[k];
+        // 2×2 minors of rows {0,1} and rows {2,3}
+        real s0 = a00*a11 - a01*a01, s1 = a00*a12 - a01*a02, s2 = a00*a13 - a01*a03;
+        real s3 = a01*a12 - a11*a02, s4 = a01*a13 - a11*a03, s5 = a02*a13 - a12*a03;
+        real c5 = a22*a33 - a23*a23, c4 = a12*a33 - a13*a23, c3 = a12*a23 - a13*a22;
+        real c2 = a02*a33 - a03*a23, c1 = a02*a23 - a03*a22, c0 = a02*a13 - a03*a12;
+        real d = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+
+        real m = std::max(std::max(std::max(std::fabs(a00), std::fabs(a01)), std::max(std::fabs(a02), std::fabs(a03))),
+                          std::max(std::max(std::fabs(a11), std::fabs(a12)), std::max(std::fabs(a13), std::fabs(a22))));
+        m = std::max(m, std::max(std::fabs(a23), std::fabs(a33)));
+        real m2 = m*m;
+        std::uint8_t good = std::uint8_t((std::fabs(d) > eps * m2 * m2) & (std::fabs(d) < std::numeric_limits<real>::infinity()));
+        real id = good ? real(1) / d : real(0);
+
+        q00[k] = ( a11*c5 - a12*c4 + a13*c3) * id;
+        q01[k] = (-a01*c5 + a02*c4 - a03*c3) * id;
+        q02[k] = ( a13*s5 - a23*s4 + a33*s3) * id;
+        q03[k] = (-a12*s5 + a22*s4 - a23*s3) * id;
+        q11[k] = ( a00*c5 - a02*c2 + a03*c1) * id;
+        q12[k] = (-a03*s5 + a23*s2 - a33*s1) * id;
+        q13[k] = ( a02*s5 - a22*s2 + a23*s1) * id;
+        q22[k] = ( a03*s4 - a13*s2 + a33*s0) * id;
+        q23[k] = (-a02*s4 + a12*s2 - a23*s0) * id;
+        q33[k] = ( a02*s3 - a12*s1 + a22*s0) * id;
+        dt[k] = d;
+        ok[k] = good;
+    }
+
+    std::size_t cnt = 0;
+    for (std::size_t k=0;k<n;++k) cnt += ok[k];
+    R.n_ok = cnt;
+}
+
+} // namespace rslm::linalg
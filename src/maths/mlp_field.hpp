@@ -0,0 +1,317 @@
+#pragma once
+/**
+ * RSLM Maths — mlp_field.hpp
+ * --------------------------
+ * Learnable metric g(x) = A(x)ᵀ η A(x), A from a small tanh MLP on
+ * x' = (x - shift) · scale, output reshaped row-major to 4×4 (plus I when the
+ * residual flag is set, so zero weights give η).
+ *
+ *  - g_batch        : whole batches through cache-blocked GEMMs (row blocks
+ *                     of points × panels of the transposed weights, contiguous
+ *                     axpy inner loop); deriv::g_points and prepare_metric_batch
+ *                     land here
+ *  - jet1_batch     : g and analytic ∂g by forward-mode propagation — each point
+ *                     carries 4 tangent rows through the same GEMMs
+ *                     (dh = (1 - h²) dz), then ∂g = ∂Aᵀ η A + Aᵀ η ∂A
+ *  - metric_jet     : g, ∂g, ∂∂g at one point (∂∂g by central differences of
+ *                     the analytic ∂g: one 9-point batch); the IMetricField
+ *                     hook, so deriv::metric_jet and riemann_at_stencil use it
+ *
+ * An empty field (default-constructed, or after a failed set_layers/load)
+ * evaluates to η with zero derivatives and logs mlp_empty_field.
+ *
+ * Weight file (little-endian, float32 payload):
+ *   char[8] "RSLMMLP1", u32 n_layers, u32 flags (bit 0: A = I + out),
+ *   f32 shift[4], f32 scale[4], n_layers × {u32 in, u32 out},
+ *   then per layer f32 W[out][in] (row-major), f32 b[out].
+ * First layer in = 4, last layer out = 16; hidden layers use tanh.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "config.hpp"
+#include "types.hpp"
+#include "linalg.hpp"
+#include "deriv.hpp"
+#include "units.hpp"
+#include "trace.hpp"
+
+namespace rslm::field {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+
+// One dense layer as stored on disk: W is out × in, row-major.
+struct MLPLayer {
+    std::size_t in{0}, out{0};
+    std::vector<real> W, b;
+};
+
+class MLPMetricField final : public IMetricField {
+public:
+    static constexpr std::size_t kRowBlock = 64;     // points per GEMM row block
+    static constexpr std::size_t kKBlock = 128;      // input panel per pass
+    static constexpr std::uint32_t kResidual = 1u;
+
+    MLPMetricField() = default;
+
+    // Takes layers in file order; false (field left empty) on inconsistent shapes.
+    bool set_layers(const std::vector<MLPLayer>& layers, std::uint32_t flags = kResidual) {
+        layers_.clear();
+        std::size_t prev = 4;
+        for (const MLPLayer& L : layers) {
+            if (L.in != prev || L.W.size() != L.in * L.out || L.b.size() != L.out) {
+                TRACE_WARN("mlp_layer_shape", L.in);
+                return false;
+            }
+            prev = L.out;
+        }
+        if (layers.empty() || prev != 16) { TRACE_WARN("mlp_output_width", prev); return false; }
+        width_ = 16;
+        for (const MLPLayer& L : layers) {
+            Dense D; D.in = L.in; D.out = L.out; D.b = L.b;
+            D.Wt.resize(L.in * L.out);
+            for (std::size_t o=0;o<L.out;++o) for (std::size_t k=0;k<L.in;++k) D.Wt[k*L.out + o] = L.W[o*L.in + k];
+            width_ = std::max(width_, L.out);
+            layers_.push_back(std::move(D));
+        }
+        flags_ = flags;
+        return true;
+    }
+
+    void set_input_transform(const vec4& shift, const vec4& scale) { shift_ = shift; scale_ = scale; }
+
+    static bool load(const std::string& path, MLPMetricField& out) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) { out.layers_.clear(); TRACE_WARN("mlp_open_failed", path); return false; }
+        bool ok = out.read(f);
+        std::fclose(f);
+        if (!ok) { out.layers_.clear(); TRACE_WARN("mlp_bad_file", path); }
+        return ok;
+    }
+
+    bool save(const std::string& path) const {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) { TRACE_WARN("mlp_open_failed", path); return false; }
+        bool ok = write(f);
+        ok = (std::fclose(f) == 0) && ok;
+        return ok;
+    }
+
+    std::size_t layers() const { return layers_.size(); }
+    bool empty() const { return layers_.empty(); }
+
+    sym4 g(const vec4& x) const override {
+        sym4 out;
+        g_batch(&x, &out, 1);
+        return out;
+    }
+
+    void g_batch(const vec4* xs, sym4* out, std::size_t n) const override {
+        for (std::size_t k0=0; k0<n; k0+=kRowBlock) {
+            const std::size_t m = std::min(kRowBlock, n - k0);
+            const real* A = forward(xs + k0, m, 1);
+            for (std::size_t k=0;k<m;++k) out[k0 + k] = from_A(A + 16*k);
+        }
+    }
+
+    // g and analytic ∂g (all four directions) at n points
+    void jet1_batch(const vec4* xs, sym4* g, rslm::deriv::DMetric4* dg, std::size_t n) const {
+        for (std::size_t k0=0; k0<n; k0+=kRowBlock) {
+            const std::size_t m = std::min(kRowBlock, n - k0);
+            const real* Y = forward(xs + k0, m, 5);
+            for (std::size_t k=0;k<m;++k) {
+                const real* A = Y + 16*5*k;
+                mat4 Am = to_mat(A), ATeta = eta_left(Am);
+                g[k0 + k] = from_A(A);
+                for (int a=0;a<4;++a) {
+                    mat4 dA = to_mat(A + 16*(a+1));
+                    mat4 P = rslm::linalg::mul(rslm::linalg::transpose(dA), eta_right(Am));
+                    mat4 Q = rslm::linalg::mul(ATeta, dA);
+                    for (int r=0;r<4;++r) for (int c=0;c<4;++c) dg[k0 + k].dg[a].m[r][c] = P.m[r][c] + Q.m[r][c];
+                }
+            }
+        }
+    }
+
+    // g, ∂g (analytic) and ∂∂g (central differences of ∂g, step h) at x
+    bool metric_jet(const vec4& x, sym4& g, rslm::deriv::DMetric4& dg, rslm::deriv::DDMetric4& ddg,
+                    real h = rslm::units::C().fd_h) const override
+    {
+        vec4 xs[9];
+        xs[0] = x;
+        for (int a=0;a<4;++a) { xs[2*a+1] = x; xs[2*a+1].v[a] += h; xs[2*a+2] = x; xs[2*a+2].v[a] -= h; }
+        sym4 gs[9];
+        rslm::deriv::DMetric4 d[9];
+        jet1_batch(xs, gs, d, 9);
+        g = gs[0]; dg = d[0];
+        const real s = real(0.5) / h;
+        for (int a=0;a<4;++a)
+            for (int b=a;b<4;++b)
+                for (int r=0;r<4;++r)
+                    for (int c=0;c<4;++c) {
+                        // average ∂_a(∂_b g) and ∂_b(∂_a g) so ddg is exactly symmetric
+                        const real v = real(0.5) * s * ((d[2*a+1].dg[b].m[r][c] - d[2*a+2].dg[b].m[r][c])
+                                                      + (d[2*b+1].dg[a].m[r][c] - d[2*b+2].dg[a].m[r][c]));
+                        ddg.ddg[a][b].m[r][c] = v;
+                        ddg.ddg[b][a].m[r][c] = v;
+                    }
+        return true;
+    }
+
+private:
+    struct Dense {
+        std::size_t in{0}, out{0};
+        std::vector<real> Wt;                  // in × out (transposed for a contiguous axpy over outputs)
+        std::vector<real> b;
+    };
+
+    // Y[r][:] = (bias_row(r) ? b : 0) + X[r][:] · Wᵀ, rows blocked by kRowBlock, inputs by kKBlock
+    static void gemm(const Dense& L, const real* X, real* Y, std::size_t rows, std::size_t stride) {
+        const std::size_t K = L.in, O = L.out;
+        for (std::size_t r=0;r<rows;++r) {
+            real* y = Y + r*O;
+            if (r % stride == 0) std::copy(L.b.begin(), L.b.end(), y);
+            else std::fill(y, y + O, real(0));
+        }
+        for (std::size_t k0=0; k0<K; k0+=kKBlock) {
+            const std::size_t k1 = std::min(K, k0 + kKBlock);
+            for (std::size_t r=0;r<rows;++r) {
+                const real* x = X + r*K;
+                real* y = Y + r*O;
+                for (std::size_t k=k0;k<k1;++k) {
+                    const real a = x[k];
+                    if (a == real(0)) continue;         // tangent rows start as unit vectors
+                    const real* w = L.Wt.data() + k*O;
+                    RSLM_VECTORIZE
+                    for (std::size_t o=0;o<O;++o) y[o] += a * w[o];
+                }
+            }
+        }
+    }
+
+    // m points, `stride` rows each (1: value only; 5: value + ∂_t,x,y,z tangents).
+    // Returns 16·stride·m outputs in thread-local scratch; A = I, ∂A = 0 when empty.
+    const real* forward(const vec4* xs, std::size_t m, std::size_t stride) const {
+        thread_local std::vector<real> buf0, buf1;
+        const std::size_t rows = m * stride;
+        buf0.resize(rows * width_); buf1.resize(rows * width_);
+        real* X = buf0.data();
+        real* Y = buf1.data();
+        if (layers_.empty()) {
+            thread_local rslm::linalg::Throttle th;
+            if (th.tick()) TRACE_WARN("mlp_empty_field", m);
+            std::fill(X, X + rows * 16, real(0));
+            for (std::size_t k=0;k<m;++k) for (int d=0;d<4;++d) X[k*stride*16 + 5*d] = real(1);
+            return X;
+        }
+        for (std::size_t k=0;k<m;++k) {
+            real* v = X + k*stride*4;
+            for (int a=0;a<4;++a) v[a] = (xs[k].v[a] - shift_.v[a]) * scale_.v[a];
+            for (std::size_t t=1;t<stride;++t)
+                for (int a=0;a<4;++a) v[t*4 + a] = (std::size_t(a) == t-1) ? scale_.v[a] : real(0);
+        }
+        for (std::size_t l=0;l<layers_.size();++l) {
+            const Dense& L = layers_[l];
+            gemm(L, X, Y, rows, stride);
+            if (l + 1 < layers_.size()) {
+                const std::size_t O = L.out;
+                for (std::size_t k=0;k<m;++k) {
+                    real* z = Y + k*stride*O;
+                    for (std::size_t o=0;o<O;++o) z[o] = std::tanh(z[o]);
+                    for (std::size_t t=1;t<stride;++t) {
+                        real* dz = z + t*O;
+                        RSLM_VECTORIZE
+                        for (std::size_t o=0;o<O;++o) dz[o] *= real(1) - z[o]*z[o];
+                    }
+                }
+            }
+            std::swap(X, Y);
+        }
+        if (flags_ & kResidual)
+            for (std::size_t k=0;k<m;++k) for (int d=0;d<4;++d) X[k*stride*16 + 5*d] += real(1);
+        return X;
+    }
+
+    static mat4 to_mat(const real* a) {
+        mat4 M;
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) M.m[r][c] = a[4*r + c];
+        return M;
+    }
+    // Aᵀ η  and  η A  (η = diag(-1,1,1,1))
+    static mat4 eta_left(const mat4& A) {
+        mat4 M = rslm::linalg::transpose(A);
+        for (int r=0;r<4;++r) M.m[r][0] = -M.m[r][0];
+        return M;
+    }
+    static mat4 eta_right(const mat4& A) {
+        mat4 M = A;
+        for (int c=0;c<4;++c) M.m[0][c] = -M.m[0][c];
+        return M;
+    }
+    static sym4 from_A(const real* a) {
+        mat4 A = to_mat(a);
+        return sym4(rslm::linalg::mul(eta_left(A), A));
+    }
+
+    bool read(std::FILE* f) {
+        char magic[8];
+        std::uint32_t nl = 0, flags = 0;
+        float io[8];
+        if (std::fread(magic, 1, 8, f) != 8 || std::memcmp(magic, "RSLMMLP1", 8) != 0) return false;
+        if (std::fread(&nl, 4, 1, f) != 1 || std::fread(&flags, 4, 1, f) != 1 || nl == 0 || nl > 64) return false;
+        if (std::fread(io, 4, 8, f) != 8) return false;
+        std::vector<MLPLayer> L(nl);
+        for (MLPLayer& l : L) {
+            std::uint32_t d[2];
+            if (std::fread(d, 4, 2, f) != 2 || d[0] == 0 || d[1] == 0 || d[0] > 4096 || d[1] > 4096) return false;
+            l.in = d[0]; l.out = d[1];
+        }
+        std::vector<float> tmp;
+        for (MLPLayer& l : L) {
+            tmp.resize(l.in * l.out + l.out);
+            if (std::fread(tmp.data(), 4, tmp.size(), f) != tmp.size()) return false;
+            l.W.assign(tmp.begin(), tmp.begin() + std::ptrdiff_t(l.in * l.out));
+            l.b.assign(tmp.begin() + std::ptrdiff_t(l.in * l.out), tmp.end());
+        }
+        if (!set_layers(L, flags)) return false;
+        set_input_transform(vec4(io[0], io[1], io[2], io[3]), vec4(io[4], io[5], io[6], io[7]));
+        return true;
+    }
+
+    bool write(std::FILE* f) const {
+        const std::uint32_t nl = std::uint32_t(layers_.size());
+        float io[8];
+        for (int a=0;a<4;++a) { io[a] = float(shift_.v[a]); io[4+a] = float(scale_.v[a]); }
+        bool ok = std::fwrite("RSLMMLP1", 1, 8, f) == 8 && std::fwrite(&nl, 4, 1, f) == 1
+               && std::fwrite(&flags_, 4, 1, f) == 1 && std::fwrite(io, 4, 8, f) == 8;
+        for (const Dense& D : layers_) {
+            const std::uint32_t d[2] = { std::uint32_t(D.in), std::uint32_t(D.out) };
+            ok = ok && std::fwrite(d, 4, 2, f) == 2;
+        }
+        std::vector<float> tmp;
+        for (const Dense& D : layers_) {
+            tmp.resize(D.in * D.out + D.out);
+            for (std::size_t o=0;o<D.out;++o) for (std::size_t k=0;k<D.in;++k) tmp[o*D.in + k] = float(D.Wt[k*D.out + o]);
+            for (std::size_t o=0;o<D.out;++o) tmp[D.in*D.out + o] = float(D.b[o]);
+            ok = ok && std::fwrite(tmp.data(), 4, tmp.size(), f) == tmp.size();
+        }
+        return ok;
+    }
+
+    std::vector<Dense> layers_;
+    std::size_t width_{16};
+    std::uint32_t flags_{kResidual};
+    vec4 shift_{0, 0, 0, 0}, scale_{1, 1, 1, 1};
+};
+
+} // namespace rslm::field
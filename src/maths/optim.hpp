@@ -0,0 +1,182 @@
+#pragma once
+/**
+ * RSLM Maths — optim.hpp
+ * ----------------------
+ * Riemannian optimizer primitives for parameters living on a Lorentzian
+ * metric field (points x ∈ M, gradients are covectors ∂f/∂x^μ):
+ *
+ *   - natural_gradient_batch : d = \tilde g⁻¹ ∇f with the PD proxy \tilde g
+ *                              (pd_proxy_square or tetrad E Eᵀ), via batched
+ *                              Cholesky solves (no explicit inverses)
+ *   - retract                : x + v − ½ Γ(x)(v,v)   (2nd-order retraction)
+ *   - exp_map                : geodesic flow for unit parameter, reusing the
+ *                              velocity-Verlet integrator (no shell renorm)
+ *   - transport              : Christoffel vector transport along the chord
+ *   - riemannian_step_batch  : preconditioned (momentum) step over n points
+ *
+ * The PD proxy shapes step *norms* only; retractions and transports use the
+ * true Lorentzian connection. Per-step scratch lives in Workspace's arena and
+ * SoA buffers, so a steady training loop does not allocate.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "linalg_batch.hpp"
+#include "field.hpp"
+#include "connection.hpp"
+#include "integrators.hpp"
+#include "tetrad.hpp"
+#include "pd_batch.hpp"
+#include "arena.hpp"
+#include "parallel.hpp"
+#include "trace.hpp"
+
+namespace rslm::opt {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+using rslm::field::IMetricField;
+
+enum class Proxy    : std::uint8_t { square = 0, tetrad = 1 };
+enum class StepKind : std::uint8_t { retraction = 0, exp_map = 1 };
+
+struct RiemannParams {
+    real lr{real(1e-2)};
+    real momentum{0};                       // β; 0 disables the momentum buffer
+    StepKind step{StepKind::retraction};
+    int exp_substeps{4};                    // Verlet substeps for exp_map
+    Proxy proxy{Proxy::square};
+    unsigned threads{0};                    // 0 = all cores
+};
+
+// Reusable scratch for batched steps (keep one per optimizer).
+struct Workspace {
+    rslm::mem::Arena arena;
+    rslm::linalg::Sym4Batch Gt, L;
+    rslm::linalg::Vec4Batch B, X;
+    rslm::audits::PDBatchReport pd;
+};
+
+// ---- Single-point primitives -----------------------------------------------
+
+// Γ^μ_{αβ} a^α b^β
+inline vec4 contract(const rslm::conn::Gamma& G, const vec4& a, const vec4& b) {
+    vec4 out;
+    for (int mu=0;mu<4;++mu) {
+        real s = 0;
+        for (int al=0;al<4;++al) for (int be=0;be<4;++be) s += G.G[mu][al][be] * a.v[al] * b.v[be];
+        out.v[mu] = s;
+    }
+    return out;
+}
+
+// Second-order retraction: agrees with exp_x(v) up to O(|v|³).
+inline vec4 retract(const IMetricField& F, const vec4& x, const vec4& v) {
+    auto M = rslm::conn::prepare_metric(F, x);
+    auto G = rslm::conn::christoffel(M);
+    vec4 c = contract(G, v, v);
+    vec4 y;
+    for (int i=0;i<4;++i) y.v[i] = x.v[i] + v.v[i] - real(0.5) * c.v[i];
+    return y;
+}
+
+// exp_x(v): integrate the geodesic with u(0)=v over τ ∈ [0,1].
+// If v_end is given it receives u(1), i.e. v parallel-transported to exp_x(v).
+inline vec4 exp_map(const IMetricField& F, const vec4& x, const vec4& v,
+                    int substeps = 4, vec4* v_end = nullptr) {
+    substeps = std::max(1, substeps);
+    vec4 y = x, u = v;
+    const real h = real(1) / real(substeps);
+    for (int s=0;s<substeps;++s) rslm::integ::geodesic_step(F, nullptr, y, u, h, /*renormalize=*/false);
+    if (v_end) *v_end = u;
+    return y;
+}
+
+// Transport w from x0 to x1 along the chord: w' = w − Γ(x̄)(Δx, w), x̄ midpoint.
+inline vec4 transport(const IMetricField& F, const vec4& x0, const vec4& x1, const vec4& w) {
+    vec4 mid, dx;
+    for (int i=0;i<4;++i) { mid.v[i] = real(0.5)*(x0.v[i] + x1.v[i]); dx.v[i] = x1.v[i] - x0.v[i]; }
+    auto M = rslm::conn::prepare_metric(F, mid);
+    auto G = rslm::conn::christoffel(M);
+    vec4 c = contract(G, dx, w);
+    vec4 out;
+    for (int i=0;i<4;++i) out.v[i] = w.v[i] - c.v[i];
+    return out;
+}
+
+// ---- Batched ---------------------------------------------------------------
+
+/**
+ * out[k] = \tilde g(x_k)⁻¹ grad[k] from metrics g[k].
+ * Returns the number of lanes whose proxy failed the PD check (out = grad there).
+ * Tetrad scratch is borrowed from ws.arena and released before returning.
+ */
+inline std::size_t natural_gradient_batch(const sym4* g, const vec4* grad, std::size_t n, vec4* out,
+                                          Workspace& ws, Proxy proxy = Proxy::square, unsigned threads = 0) {
+    if (proxy == Proxy::tetrad) {
+        const auto mark = ws.arena.mark();
+        mat4* E = ws.arena.alloc_zeroed<mat4>(n);
+        rslm::par::parallel_for(n, [&](std::size_t b, std::size_t e) {
+            mat4 gt;
+            for (std::size_t k=b;k<e;++k) rslm::tetrad::build_tetrad(g[k], E[k], gt);
+        }, threads);
+        rslm::audits::pd_proxy_tetrad_batch(E, n, ws.Gt);
+        ws.arena.rollback(mark);
+    } else {
+        rslm::audits::pd_proxy_square_batch(g, n, ws.Gt);
+    }
+    rslm::audits::cholesky4_batch(ws.Gt, ws.L, ws.pd);
+    rslm::linalg::pack(grad, n, ws.B);
+    rslm::audits::chol_solve_batch(ws.L, ws.pd, ws.B, ws.X);
+    rslm::linalg::unpack(ws.X, out);
+    return n - ws.pd.n_ok;
+}
+
+/**
+ * One preconditioned Riemannian step over n parameters (in place):
+ *     m ← β m − lr \tilde g⁻¹ ∇f        (m = −lr \tilde g⁻¹ ∇f if mom == nullptr)
+ *     x ← R_x(m)                         (retraction or exp map)
+ *     m ← T_{x→x'}(m)                    (so the buffer lives at the new point)
+ * Returns the number of non-PD lanes that fell back to the raw gradient.
+ */
+inline std::size_t riemannian_step_batch(const IMetricField& F, vec4* x, const vec4* grad, vec4* mom,
+                                         std::size_t n, const RiemannParams& P, Workspace& ws) {
+    ws.arena.reset();
+    sym4* g = ws.arena.alloc_zeroed<sym4>(n);
+    vec4* d = ws.arena.alloc_zeroed<vec4>(n);
+
+    rslm::par::parallel_for(n, [&](std::size_t b, std::size_t e) {
+        for (std::size_t k=b;k<e;++k) g[k] = F.g(x[k]);
+    }, P.threads);
+
+    std::size_t fallback = natural_gradient_batch(g, grad, n, d, ws, P.proxy, P.threads);
+
+    rslm::par::parallel_for(n, [&](std::size_t b, std::size_t e) {
+        for (std::size_t k=b;k<e;++k) {
+            vec4 v;
+            for (int i=0;i<4;++i) v.v[i] = (mom ? P.momentum * mom[k].v[i] : real(0)) - P.lr * d[k].v[i];
+
+            vec4 x1, v1;
+            if (P.step == StepKind::exp_map) {
+                x1 = exp_map(F, x[k], v, P.exp_substeps, &v1);
+            } else {
+                x1 = retract(F, x[k], v);
+                if (mom) v1 = transport(F, x[k], x1, v);
+            }
+            if (mom) mom[k] = v1;
+            x[k] = x1;
+        }
+    }, P.threads, 16);
+
+    if (fallback) TRACE_WARN("riemannian_step_non_pd", fallback);
+    return fallback;
+}
+
+} // namespace rslm::opt
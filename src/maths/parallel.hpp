@@ -0,0 +1,74 @@
+#pragma once
+/**
+ * RSLM Maths — parallel.hpp
+ * -------------------------
+ * Minimal fork-join helpers on std::thread (no pool, no dependencies).
+ *  - parallel_chunks(n, nchunks, fn(chunk, begin, end)) : fixed, deterministic
+ *    chunk boundaries, so per-chunk partials merge in a reproducible order
+ *  - parallel_for(n, fn(begin, end))                     : convenience wrapper
+ *
+ * Work runs inline when one thread is requested or n is small. The first
+ * exception thrown by a worker is rethrown on the calling thread after join.
+ */
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace rslm::par {
+
+inline unsigned hardware_threads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1u;
+}
+
+// Resolve a thread request (0 = all cores) against the amount of work.
+inline unsigned resolve_threads(unsigned threads, std::size_t n, std::size_t min_chunk = 64) {
+    unsigned t = threads ? threads : hardware_threads();
+    std::size_t cap = std::max<std::size_t>(1, n / std::max<std::size_t>(1, min_chunk));
+    return unsigned(std::min<std::size_t>(t, cap));
+}
+
+template <typename Fn>
+inline void parallel_chunks(std::size_t n, std::size_t nchunks, Fn&& fn, unsigned threads = 0) {
+    if (n == 0 || nchunks == 0) return;
+    nchunks = std::min(nchunks, n);
+    auto bounds = [&](std::size_t c) { return c * n / nchunks; };
+
+    unsigned nt = std::min<std::size_t>(threads ? threads : hardware_threads(), nchunks);
+    if (nt <= 1) {
+        for (std::size_t c=0;c<nchunks;++c) fn(c, bounds(c), bounds(c+1));
+        return;
+    }
+
+    std::exception_ptr err;
+    std::mutex err_mtx;
+    std::vector<std::thread> pool;
+    pool.reserve(nt);
+    for (unsigned t=0;t<nt;++t) {
+        pool.emplace_back([&, t] {
+            // static round-robin assignment of chunks to workers
+            for (std::size_t c=t;c<nchunks;c+=nt) {
+                try { fn(c, bounds(c), bounds(c+1)); }
+                catch (...) {
+                    std::scoped_lock lk(err_mtx);
+                    if (!err) err = std::current_exception();
+                    return;
+                }
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+    if (err) std::rethrow_exception(err);
+}
+
+template <typename Fn>
+inline void parallel_for(std::size_t n, Fn&& fn, unsigned threads = 0, std::size_t min_chunk = 64) {
+    unsigned nt = resolve_threads(threads, n, min_chunk);
+    parallel_chunks(n, nt, [&](std::size_t, std::size_t b, std::size_t e) { fn(b, e); }, nt);
+}
+
+} // namespace rslm::par
@@ -4,10 +4,17 @@
  * -------------------------------------
  * Build Einstein tensor G_{μν} from curvature and compute the Frobenius
  * residual || G - κ T ||_F for diagnostics.
+ *
+ * KappaAccumulator streams Σ⟨G,G⟩, Σ⟨G,T⟩, Σ⟨T,T⟩ (per component) over a
+ * sweep, so Σ‖G - κT‖² = GG - 2κ GT + κ² TT is available for every κ after
+ * one pass; κ* = GT / TT minimizes it.
  */
 
 #include <cmath>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 #include "config.hpp"
 #include "linalg.hpp"
@@ -15,6 +22,8 @@
 #include "connection.hpp"
 #include "field.hpp"
 #include "stress_energy.hpp"
+#include "parallel.hpp"
+#include "trace.hpp"
 
 namespace rslm::phys {
 
@@ -71,4 +80,76 @@ inline real residual_norm(const IMetricField& F,
     return frob(R);
 }
 
+struct KappaAccumulator {
+    std::uint64_t n{0};
+    long double gg[4][4]{}, gt[4][4]{}, tt[4][4]{};    // per component (μ,ν)
+
+    inline void push(const mat4& G, const mat4& T) {
+        ++n;
+        for (int i=0;i<4;++i)
+            for (int j=0;j<4;++j) {
+                long double g = G.m[i][j], t = T.m[i][j];
+                gg[i][j] += g*g; gt[i][j] += g*t; tt[i][j] += t*t;
+            }
+    }
+
+    inline void merge(const KappaAccumulator& o) {
+        n += o.n;
+        for (int i=0;i<4;++i)
+            for (int j=0;j<4;++j) { gg[i][j] += o.gg[i][j]; gt[i][j] += o.gt[i][j]; tt[i][j] += o.tt[i][j]; }
+    }
+
+    inline long double sum_gg() const { long double s=0; for (int i=0;i<4;++i) for (int j=0;j<4;++j) s += gg[i][j]; return s; }
+    inline long double sum_gt() const { long double s=0; for (int i=0;i<4;++i) for (int j=0;j<4;++j) s += gt[i][j]; return s; }
+    inline long double sum_tt() const { long double s=0; for (int i=0;i<4;++i) for (int j=0;j<4;++j) s += tt[i][j]; return s; }
+
+    // argmin_κ Σ‖G - κT‖²; returns false (κ untouched) when T vanished on every sample
+    inline bool kappa_opt(real& kappa) const {
+        long double t = sum_tt();
+        if (!(t > 0)) { TRACE_WARN("kappa_opt_no_source", real(t)); return false; }
+        kappa = real(sum_gt() / t);
+        return true;
+    }
+
+    // Σ‖G - κT‖²_F (clamped at 0 against round-off)
+    inline real residual_sq(real kappa) const {
+        long double k = kappa;
+        return real(std::max<long double>(0, sum_gg() - 2*k*sum_gt() + k*k*sum_tt()));
+    }
+    // Σ (G - κT)_{μν}², one component
+    inline real residual_sq(real kappa, int i, int j) const {
+        long double k = kappa;
+        return real(std::max<long double>(0, gg[i][j] - 2*k*gt[i][j] + k*k*tt[i][j]));
+    }
+    // root mean square of ‖G - κT‖_F over the pushed samples
+    inline real residual_rms(real kappa) const {
+        return n ? std::sqrt(residual_sq(kappa) / real(n)) : real(0);
+    }
+    // Σ‖G - κT‖² for each κ in `kappas`
+    inline std::vector<real> curve(const std::vector<real>& kappas) const {
+        std::vector<real> out(kappas.size());
+        for (std::size_t k=0;k<kappas.size();++k) out[k] = residual_sq(kappas[k]);
+        return out;
+    }
+};
+
+/**
+ * One pass of G and T over points xs[0..n): per-chunk accumulators merged in
+ * chunk order, so the sums do not depend on the thread count.
+ */
+inline KappaAccumulator kappa_sweep(const IMetricField& F, const std::vector<Event>& evs,
+                                    const rslm::linalg::vec4* xs, std::size_t n, const TSParams& P,
+                                    unsigned threads = 0, std::size_t nchunks = 64)
+{
+    nchunks = std::max<std::size_t>(1, std::min(nchunks, n));
+    std::vector<KappaAccumulator> part(nchunks);
+    rslm::par::parallel_chunks(n, nchunks, [&](std::size_t c, std::size_t b, std::size_t e) {
+        for (std::size_t k=b;k<e;++k)
+            part[c].push(to_mat4(einstein_at(F, xs[k])), stress_energy_at(F, evs, xs[k], P));
+    }, threads);
+    KappaAccumulator acc;
+    for (const auto& p : part) acc.merge(p);
+    return acc;
+}
+
 } // namespace rslm::phys
@@ -0,0 +1,412 @@
+#pragma once
+/**
+ * RSLM Maths — physics/metric_fit.hpp
+ * -----------------------------------
+ * Levenberg–Marquardt fit of a LatticeMetricField to an event cloud:
+ *
+ *   min_c  ½ Σ_s ‖G(x_s) - κ T(x_s)‖_F²  +  ½ τ ‖c‖²
+ *
+ * Per sample, G comes from the spline's closed-form jet via riemann_from_jet
+ * (no finite-difference field stencils), and T = g S g + M g with the event
+ * sums S, M (see stress_mesh.hpp) frozen at the current metric for one
+ * Gauss–Newton linearization. The residual Jacobian is exact through the
+ * spline: ∂r/∂c = ∂r/∂jet · ∂jet/∂c, where ∂jet/∂c are the B-spline weights
+ * and ∂r/∂jet is taken over the 100 jet entries (central differences in
+ * jet space, which costs no field evaluations; ∂T/∂g is analytic).
+ *
+ * The damped normal equations (JᵀJ + λ·diag(JᵀJ) + τI) δ = -(Jᵀr + τc) are
+ * solved matrix-free by Jacobi-preconditioned CG; J·v runs over samples and
+ * Jᵀ·y over lattice nodes (each node gathers its stencil entries in sample
+ * order), so no thread keeps a dense copy of the gradient.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "config.hpp"
+#include "types.hpp"
+#include "linalg.hpp"
+#include "connection.hpp"
+#include "curvature.hpp"
+#include "lattice_field.hpp"
+#include "pd_proxy.hpp"
+#include "stress_energy.hpp"
+#include "parallel.hpp"
+#include "trace.hpp"
+
+namespace rslm::phys {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::mat4;
+using rslm::linalg::sym4;
+using rslm::linalg::sym_idx;
+using rslm::field::LatticeMetricField;
+using rslm::field::SplineStencil;
+
+struct MetricFitOptions {
+    std::size_t max_iters{20};
+    real tikhonov{real(1e-8)};      // τ
+    real lambda0{real(1e-3)};       // initial LM damping
+    std::size_t cg_iters{200};
+    real cg_tol{real(1e-8)};        // relative CG residual
+    real tol{real(1e-10)};          // stop when the relative cost decrease falls below
+    real jet_h{real(1e-6)};         // jet-space difference step
+    unsigned threads{0};
+};
+
+struct MetricFitReport {
+    std::size_t iters{0}, cg_total{0};
+    real cost0{0}, cost{0};
+    bool converged{false};          // relative cost decrease fell below tol
+    bool stalled{false};            // no damped step lowered the cost (not converged)
+};
+
+// 100 jet entries per sample: comp p (sym_idx order) × {g, ∂x, ∂y, ∂z, ∂xx, ∂xy, ∂xz, ∂yy, ∂yz, ∂zz}
+inline constexpr int kJetPerComp = 10;
+inline constexpr int kJetLen = 10 * kJetPerComp;
+inline constexpr int kResLen = 10;                   // G - κT, upper triangle (off-diagonals ×√2)
+
+namespace detail {
+
+// Event sums at x for metric g: S^{αβ} = Σ φ E u^α u^β, M = Σ φ η m c²
+inline void source_sums(const sym4& g, const std::vector<Event>& evs, const vec4& x, const TSParams& P,
+                        real S[4][4], real& M)
+{
+    mat4 gt = rslm::audits::pd_proxy_square(g);
+    for (int r=0;r<4;++r) for (int c=0;c<4;++c) S[r][c] = 0;
+    M = 0;
+    for (const Event& e : evs) {
+        real d[4] = { x.v[0]-e.x.v[0], x.v[1]-e.x.v[1], x.v[2]-e.x.v[2], x.v[3]-e.x.v[3] };
+        real d2 = 0;
+        for (int i=0;i<4;++i) { real s = 0; for (int j=0;j<4;++j) s += gt.m[i][j]*d[j]; d2 += d[i]*s; }
+        real w = kernel_exp(d2, P.sigma);
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) S[r][c] += w * e.E * e.u.v[r] * e.u.v[c];
+        M += w * P.eta * e.m * P.c2;
+    }
+}
+
+// jet vector → {g, g⁻¹, ∂g} + ∂∂g
+inline void jet_unpack(const real* J, rslm::conn::MetricPack& Mp, rslm::deriv::DDMetric4& dd) {
+    for (int r=0;r<4;++r)
+        for (int c=0;c<4;++c) {
+            const int p = sym_idx(r,c);
+            Mp.g.m[r][c] = J[p*kJetPerComp];
+            Mp.dg.dg[0].m[r][c] = 0;
+            for (int a=0;a<3;++a) Mp.dg.dg[a+1].m[r][c] = J[p*kJetPerComp + 1 + a];
+            for (int a=0;a<4;++a) dd.ddg[0][a].m[r][c] = dd.ddg[a][0].m[r][c] = 0;
+            for (int q=0;q<6;++q) {
+                const real v = J[p*kJetPerComp + 4 + q];
+                dd.ddg[rslm::field::kPairA[q]+1][rslm::field::kPairB[q]+1].m[r][c] = v;
+                dd.ddg[rslm::field::kPairB[q]+1][rslm::field::kPairA[q]+1].m[r][c] = v;
+            }
+        }
+    real det = 0, cond = 0;
+    Mp.inv_ok = rslm::linalg::inverse(Mp.g, Mp.g_inv, det, cond, real(1e-14));
+}
+
+// r = upper triangle of G(jet) - κ (g S g + M g), off-diagonals scaled by √2
+inline void residual_from_jet(const real* J, const real S[4][4], real M, real kappa, real* r) {
+    rslm::conn::MetricPack Mp;
+    rslm::deriv::DDMetric4 dd;
+    jet_unpack(J, Mp, dd);
+    auto Rm = rslm::curv::riemann_from_jet(Mp, dd);
+    auto Rc = rslm::curv::ricci(Rm);
+    real R = rslm::curv::scalar(Mp.g_inv, Rc);
+    const auto& g = Mp.g.m;
+    real gS[4][4];
+    for (int a=0;a<4;++a) for (int b=0;b<4;++b) { real s = 0; for (int k=0;k<4;++k) s += g[a][k]*S[k][b]; gS[a][b] = s; }
+    const real sq2 = std::sqrt(real(2));
+    for (int a=0;a<4;++a)
+        for (int b=a;b<4;++b) {
+            real T = M * g[a][b];
+            for (int k=0;k<4;++k) T += gS[a][k] * g[k][b];
+            real G = real(0.5) * (Rc.m[a][b] + Rc.m[b][a]) - real(0.5) * g[a][b] * R;
+            r[sym_idx(a,b)] = (G - kappa * T) * (a == b ? real(1) : sq2);
+        }
+}
+
+struct SampleLin {
+    SplineStencil st;
+    real r[kResLen];
+    real dr[kResLen][kJetLen];          // ∂r/∂jet
+};
+
+} // namespace detail
+
+class LatticeMetricFitter {
+public:
+    LatticeMetricFitter(LatticeMetricField& F, const std::vector<Event>& evs,
+                        std::vector<vec4> samples, const TSParams& P)
+        : F_(F), evs_(evs), xs_(std::move(samples)), P_(P) {}
+
+    // ½ Σ ‖r‖² + ½ τ ‖c‖² at the current coefficients (sources re-evaluated)
+    real cost(real tau) const {
+        std::vector<real> part(xs_.size());
+        rslm::par::parallel_for(xs_.size(), [&](std::size_t b, std::size_t e) {
+            SplineStencil st; real J[kJetLen], r[kResLen], S[4][4], M;
+            for (std::size_t s=b;s<e;++s) {
+                F_.stencil(xs_[s], st);
+                jet_of(st, J);
+                detail::source_sums(F_.g(xs_[s]), evs_, xs_[s], P_, S, M);
+                detail::residual_from_jet(J, S, M, P_.kappa, r);
+                real q = 0; for (int i=0;i<kResLen;++i) q += r[i]*r[i];
+                part[s] = q;
+            }
+        }, threads_, 8);
+        long double acc = 0;
+        for (real v : part) acc += v;
+        acc *= 0.5L;
+        long double cc = 0;
+        for (int p=0;p<10;++p) for (real v : F_.coeffs().c[p]) cc += (long double)v * v;
+        return real(acc + 0.5L * tau * cc);
+    }
+
+    // True once the relative cost decrease falls below opt.tol; false on a
+    // stall, after max_iters, or on empty input. F keeps the lowest-cost
+    // coefficients reached in every case.
+    bool run(const MetricFitOptions& opt, MetricFitReport* rep = nullptr) {
+        threads_ = opt.threads;
+        const std::size_t nn = F_.nodes(), nv = 10 * nn;
+        if (nn == 0 || xs_.empty()) { TRACE_WARN("metric_fit_empty", xs_.size()); return false; }
+        MetricFitReport R;
+        real lambda = opt.lambda0;
+        R.cost0 = R.cost = cost(opt.tikhonov);
+        std::vector<detail::SampleLin> lin(xs_.size());
+        std::vector<real> c0(nv), grad(nv), diag(nv), delta(nv);
+
+        for (R.iters=0; R.iters<opt.max_iters; ) {
+            linearize(lin, opt.jet_h);
+            if (R.iters == 0) index_nodes(lin);
+            ++R.iters;
+            // gradient Jᵀr + τc and diag(JᵀJ)
+            std::vector<real> rr(xs_.size() * kResLen);
+            for (std::size_t s=0;s<xs_.size();++s) std::copy(lin[s].r, lin[s].r + kResLen, &rr[s*kResLen]);
+            jt_apply(lin, rr, grad);
+            jtj_diag(lin, diag);
+            save(c0);
+            for (std::size_t q=0;q<nv;++q) grad[q] += opt.tikhonov * c0[q];
+
+            bool accepted = false;
+            for (int tries=0; tries<8 && !accepted; ++tries) {
+                R.cg_total += cg(lin, diag, lambda, opt.tikhonov, grad, delta, opt.cg_iters, opt.cg_tol);
+                for (std::size_t q=0;q<nv;++q) set(q, c0[q] + delta[q]);
+                real cnew = cost(opt.tikhonov);
+                if (std::isfinite(cnew) && cnew < R.cost) {
+                    real rel = (R.cost - cnew) / std::max(R.cost, real(1e-300));
+                    R.cost = cnew;
+                    lambda = std::max(lambda / 3, real(1e-12));
+                    accepted = true;
+                    if (rel < opt.tol) R.converged = true;
+                } else {
+                    for (std::size_t q=0;q<nv;++q) set(q, c0[q]);
+                    lambda *= 4;
+                }
+            }
+            TRACE_DEBUG("metric_fit_cost", R.cost);
+            if (!accepted) { R.stalled = true; TRACE_WARN("metric_fit_stalled", R.cost); break; }
+            if (R.converged) break;
+        }
+        if (rep) *rep = R;
+        return R.converged;
+    }
+
+private:
+    // value index q = p·nodes + n ↔ coefficient component p of node n
+    real get(std::size_t q) const { return F_.coeffs().c[q / F_.nodes()][q % F_.nodes()]; }
+    void set(std::size_t q, real v) { F_.coeffs().c[q / F_.nodes()][q % F_.nodes()] = v; }
+    void save(std::vector<real>& c) const { for (std::size_t q=0;q<c.size();++q) c[q] = get(q); }
+
+    void jet_of(const SplineStencil& st, real* J) const {
+        std::fill(J, J + kJetLen, real(0));
+        const auto& C = F_.coeffs().c;
+        for (int q=0;q<64;++q) {
+            const std::size_t n = st.node[q];
+            for (int p=0;p<10;++p) {
+                const real c = C[p][n];
+                real* Jp = J + p*kJetPerComp;
+                Jp[0] += st.w[q] * c;
+                for (int a=0;a<3;++a) Jp[1+a] += st.d1[q][a] * c;
+                for (int r=0;r<6;++r) Jp[4+r] += st.d2[q][r] * c;
+            }
+        }
+        for (int r=0;r<4;++r) J[sym_idx(r,r)*kJetPerComp] += (r == 0 ? real(-1) : real(1));   // + η
+    }
+
+    // basis weights of stencil entry q for jet slot e (0 value, 1..3 ∂, 4..9 ∂∂)
+    static real wt(const SplineStencil& st, int q, int e) {
+        return e == 0 ? st.w[q] : (e < 4 ? st.d1[q][e-1] : st.d2[q][e-4]);
+    }
+
+    void linearize(std::vector<detail::SampleLin>& lin, real h) const {
+        rslm::par::parallel_for(xs_.size(), [&](std::size_t b, std::size_t e) {
+            real J[kJetLen], Jp[kJetLen], rp[kResLen], rm[kResLen], S[4][4], M;
+            for (std::size_t s=b;s<e;++s) {
+                detail::SampleLin& L = lin[s];
+                F_.stencil(xs_[s], L.st);
+                jet_of(L.st, J);
+                detail::source_sums(F_.g(xs_[s]), evs_, xs_[s], P_, S, M);
+                detail::residual_from_jet(J, S, M, P_.kappa, L.r);
+                for (int k=0;k<kJetLen;++k) {
+                    const real step = h * std::max(real(1), std::fabs(J[k]));
+                    std::copy(J, J + kJetLen, Jp);
+                    Jp[k] = J[k] + step; detail::residual_from_jet(Jp, S, M, P_.kappa, rp);
+                    Jp[k] = J[k] - step; detail::residual_from_jet(Jp, S, M, P_.kappa, rm);
+                    for (int i=0;i<kResLen;++i) L.dr[i][k] = (rp[i] - rm[i]) / (2*step);
+                }
+            }
+        }, threads_, 4);
+    }
+
+    // y = J v  (per sample, kResLen rows)
+    void j_apply(const std::vector<detail::SampleLin>& lin, const std::vector<real>& v, std::vector<real>& y) const {
+        const std::size_t nn = F_.nodes();
+        y.assign(lin.size() * kResLen, real(0));
+        rslm::par::parallel_for(lin.size(), [&](std::size_t b, std::size_t e) {
+            real dJ[kJetLen];
+            for (std::size_t s=b;s<e;++s) {
+                const detail::SampleLin& L = lin[s];
+                std::fill(dJ, dJ + kJetLen, real(0));
+                for (int q=0;q<64;++q)
+                    for (int p=0;p<10;++p) {
+                        const real vq = v[std::size_t(p)*nn + L.st.node[q]];
+                        if (vq == 0) continue;
+                        for (int k=0;k<kJetPerComp;++k) dJ[p*kJetPerComp + k] += wt(L.st, q, k) * vq;
+                    }
+                for (int i=0;i<kResLen;++i) {
+                    real acc = 0;
+                    for (int k=0;k<kJetLen;++k) acc += L.dr[i][k] * dJ[k];
+                    y[s*kResLen + i] = acc;
+                }
+            }
+        }, threads_, 16);
+    }
+
+    // node → stencil entries (s·64 + q) touching it, CSR in sample order, with
+    // their basis weights; the stencils are fixed by the samples, so this is
+    // built once per run
+    void index_nodes(const std::vector<detail::SampleLin>& lin) {
+        const std::size_t nn = F_.nodes();
+        node_ptr_.assign(nn + 1, 0);
+        for (const auto& L : lin) for (int q=0;q<64;++q) ++node_ptr_[L.st.node[q] + 1];
+        for (std::size_t n=0;n<nn;++n) node_ptr_[n+1] += node_ptr_[n];
+        node_ent_.resize(node_ptr_[nn]);
+        std::vector<std::size_t> fill(node_ptr_.begin(), node_ptr_.end() - 1);
+        for (std::size_t s=0;s<lin.size();++s)
+            for (int q=0;q<64;++q) node_ent_[fill[lin[s].st.node[q]]++] = s*64 + std::size_t(q);
+        node_wt_.resize(node_ent_.size() * kJetPerComp);
+        for (std::size_t t=0;t<node_ent_.size();++t)
+            for (int k=0;k<kJetPerComp;++k)
+                node_wt_[t*kJetPerComp + k] = wt(lin[node_ent_[t] / 64].st, int(node_ent_[t] % 64), k);
+    }
+
+    // g = Jᵀ y: per-sample jet vectors, then a gather per node (each node sums
+    // its entries in sample order, so no per-thread copies of g and the result
+    // does not depend on the thread count)
+    void jt_apply(const std::vector<detail::SampleLin>& lin, const std::vector<real>& y, std::vector<real>& g) {
+        const std::size_t nn = F_.nodes();
+        dj_.resize(lin.size() * kJetLen);
+        rslm::par::parallel_for(lin.size(), [&](std::size_t b, std::size_t e) {
+            for (std::size_t s=b;s<e;++s) {
+                const detail::SampleLin& L = lin[s];
+                real* dJ = dj_.data() + s*kJetLen;
+                for (int k=0;k<kJetLen;++k) {
+                    real acc = 0;
+                    for (int i=0;i<kResLen;++i) acc += L.dr[i][k] * y[s*kResLen + i];
+                    dJ[k] = acc;
+                }
+            }
+        }, threads_, 16);
+        g.assign(10 * nn, real(0));
+        rslm::par::parallel_for(nn, [&](std::size_t b, std::size_t e) {
+            for (std::size_t n=b;n<e;++n)
+                for (std::size_t t=node_ptr_[n]; t<node_ptr_[n+1]; ++t) {
+                    const real* w = node_wt_.data() + t*kJetPerComp;
+                    const real* dJ = dj_.data() + (node_ent_[t] / 64)*kJetLen;
+                    for (int p=0;p<10;++p) {
+                        real acc = 0;
+                        for (int k=0;k<kJetPerComp;++k) acc += w[k] * dJ[p*kJetPerComp + k];
+                        g[std::size_t(p)*nn + n] += acc;
+                    }
+                }
+        }, threads_, 8);
+    }
+
+    // diag(JᵀJ): Σ_s Σ_i (∂r_i/∂c_q)², gathered per node like jt_apply
+    void jtj_diag(const std::vector<detail::SampleLin>& lin, std::vector<real>& d) const {
+        const std::size_t nn = F_.nodes();
+        d.assign(10 * nn, real(0));
+        rslm::par::parallel_for(nn, [&](std::size_t b, std::size_t e) {
+            for (std::size_t n=b;n<e;++n)
+                for (std::size_t t=node_ptr_[n]; t<node_ptr_[n+1]; ++t) {
+                    const detail::SampleLin& L = lin[node_ent_[t] / 64];
+                    const int q = int(node_ent_[t] % 64);
+                    for (int p=0;p<10;++p) {
+                        real sq = 0;
+                        for (int i=0;i<kResLen;++i) {
+                            real jij = 0;
+                            for (int k=0;k<kJetPerComp;++k) jij += L.dr[i][p*kJetPerComp + k] * wt(L.st, q, k);
+                            sq += jij * jij;
+                        }
+                        d[std::size_t(p)*nn + n] += sq;
+                    }
+                }
+        }, threads_, 8);
+    }
+
+    // (JᵀJ + λ·diag + τ) δ = -grad; returns CG iterations
+    std::size_t cg(const std::vector<detail::SampleLin>& lin, const std::vector<real>& diag, real lambda, real tau,
+                   const std::vector<real>& grad, std::vector<real>& x, std::size_t max_it, real tol)
+    {
+        const std::size_t nv = grad.size();
+        std::vector<real> r(nv), z(nv), p(nv), Ap(nv), Jp, pre(nv);
+        for (std::size_t q=0;q<nv;++q) pre[q] = real(1) / ((1 + lambda) * diag[q] + tau + real(1e-300));
+        x.assign(nv, real(0));
+        for (std::size_t q=0;q<nv;++q) { r[q] = -grad[q]; z[q] = pre[q] * r[q]; p[q] = z[q]; }
+        auto dot = [&](const std::vector<real>& a, const std::vector<real>& b) {
+            long double s = 0; for (std::size_t q=0;q<nv;++q) s += (long double)a[q] * b[q]; return real(s);
+        };
+        real rz = dot(r, z);
+        const real r0 = std::sqrt(dot(r, r));
+        if (!(r0 > 0)) return 0;
+        std::size_t it = 0;
+        for (; it<max_it; ++it) {
+            j_apply(lin, p, Jp);
+            jt_apply(lin, Jp, Ap);
+            for (std::size_t q=0;q<nv;++q) Ap[q] += (lambda * diag[q] + tau) * p[q];
+            real pAp = dot(p, Ap);
+            if (!(pAp > 0)) break;
+            real alpha = rz / pAp;
+            for (std::size_t q=0;q<nv;++q) { x[q] += alpha * p[q]; r[q] -= alpha * Ap[q]; }
+            if (std::sqrt(dot(r, r)) <= tol * r0) { ++it; break; }
+            for (std::size_t q=0;q<nv;++q) z[q] = pre[q] * r[q];
+            real rz1 = dot(r, z);
+            real beta = rz1 / rz;
+            rz = rz1;
+            for (std::size_t q=0;q<nv;++q) p[q] = z[q] + beta * p[q];
+        }
+        return it;
+    }
+
+    LatticeMetricField& F_;
+    const std::vector<Event>& evs_;
+    std::vector<vec4> xs_;
+    TSParams P_;
+    unsigned threads_{0};
+    std::vector<std::size_t> node_ptr_, node_ent_;   // index_nodes()
+    std::vector<real> node_wt_;                      // kJetPerComp basis weights per entry
+    std::vector<real> dj_;                           // jt_apply scratch, kJetLen per sample
+};
+
+// One-call form: fit F's coefficients in place on the given sample points.
+inline bool fit_lattice_metric(LatticeMetricField& F, const std::vector<Event>& evs,
+                               const std::vector<vec4>& samples, const TSParams& P,
+                               const MetricFitOptions& opt = {}, MetricFitReport* rep = nullptr)
+{
+    LatticeMetricFitter fit(F, evs, samples, P);
+    return fit.run(opt, rep);
+}
+
+} // namespace rslm::phys
@@ -0,0 +1,489 @@
+#pragma once
+/**
+ * RSLM Maths — physics/poisson.hpp
+ * --------------------------------
+ * Newtonian-limit potential sourced by event energy density:
+ *
+ *   ∇²V = 4πG ρ,   ρ(x) = Σ_i φσ(|x - x_i|) T_00,i   (flat lowering at t0:
+ *                  T_00,i = E_i (u_i^0)² - η m_i c², same kernel as T_{μν})
+ *
+ *  - Lattice3            : scalar field on a vertex lattice over (x, y, z), spacing h
+ *  - density_from_events : CIC splat + separable 3D Gaussian (periodic or zero-padded)
+ *  - solve_poisson_fft   : periodic box, dims powers of two; exact inverse of the
+ *                          7-point Laplacian (mean of ρ removed, mean V = 0)
+ *  - solve_poisson_mg    : isolated box, dims 2^k + 1; V-cycle multigrid with the
+ *                          monopole -G·M/r as Dirichlet boundary
+ *  - LatticePotential    : IPotential over a solved lattice; Catmull-Rom tricubic V
+ *                          and the analytic gradient of that interpolant (C¹);
+ *                          ignores t like RadialPotential. Outside the box:
+ *                          periodic wrap, or the monopole for isolated boxes.
+ *
+ * Failures (bad dims, empty lattice) return false with a TRACE_WARN.
+ */
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "config.hpp"
+#include "types.hpp"
+#include "linalg.hpp"
+#include "parallel.hpp"
+#include "stress_mesh.hpp"
+#include "trace.hpp"
+
+namespace rslm::phys {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::field::IPotential;
+
+inline constexpr real kPi = real(3.14159265358979323846);
+
+enum class PoissonBC { kPeriodic, kIsolated };
+
+struct Lattice3 {
+    std::size_t nx{0}, ny{0}, nz{0};
+    real x0{0}, y0{0}, z0{0}, h{1};          // vertex (i,j,k) at (x0 + i·h, y0 + j·h, z0 + k·h)
+    std::vector<real> v;                     // size nx·ny·nz, index (k·ny + j)·nx + i
+
+    void resize(std::size_t nx_, std::size_t ny_, std::size_t nz_) {
+        nx = nx_; ny = ny_; nz = nz_;
+        v.assign(nx*ny*nz, real(0));
+    }
+    std::size_t idx(std::size_t i, std::size_t j, std::size_t k) const { return (k*ny + j)*nx + i; }
+    real&       at(std::size_t i, std::size_t j, std::size_t k)       { return v[idx(i,j,k)]; }
+    const real& at(std::size_t i, std::size_t j, std::size_t k) const { return v[idx(i,j,k)]; }
+};
+
+// Lattice with the same geometry as L and zero values
+inline Lattice3 like(const Lattice3& L) {
+    Lattice3 o = L;
+    std::fill(o.v.begin(), o.v.end(), real(0));
+    return o;
+}
+
+inline real t00_flat(const Event& e, const TSParams& P) {
+    return e.E * e.u.v[0] * e.u.v[0] - P.eta * e.m * P.c2;
+}
+
+namespace detail {
+
+// In-place 1D Gaussian along one axis of L (periodic wrap or zero outside).
+inline void blur_axis(Lattice3& L, int axis, const std::vector<real>& taps, bool periodic, unsigned threads) {
+    const std::size_t n  = axis == 0 ? L.nx : (axis == 1 ? L.ny : L.nz);
+    const std::size_t st = axis == 0 ? 1 : (axis == 1 ? L.nx : L.nx*L.ny);
+    const std::size_t lines = L.v.size() / n;
+    const long R = long(taps.size() / 2);
+    rslm::par::parallel_for(lines, [&](std::size_t b, std::size_t e) {
+        std::vector<real> in(n);
+        for (std::size_t ln=b; ln<e; ++ln) {
+            // base offset of line ln: enumerate the other two axes
+            std::size_t base;
+            if (axis == 0)      base = ln * L.nx;
+            else if (axis == 1) base = (ln / L.nx) * L.nx * L.ny + (ln % L.nx);
+            else                base = ln;
+            for (std::size_t q=0;q<n;++q) in[q] = L.v[base + q*st];
+            for (std::size_t q=0;q<n;++q) {
+                real acc = 0;
+                for (long d=-R; d<=R; ++d) {
+                    long p = long(q) + d;
+                    if (periodic) p = ((p % long(n)) + long(n)) % long(n);
+                    else if (p < 0 || p >= long(n)) continue;
+                    acc += taps[std::size_t(d + R)] * in[std::size_t(p)];
+                }
+                L.v[base + q*st] = acc;
+            }
+        }
+    }, threads, 16);
+}
+
+// Iterative radix-2 FFT (n a power of two); inverse=true omits the 1/n.
+inline void fft(std::complex<real>* a, std::size_t n, bool inverse) {
+    for (std::size_t i=1, j=0; i<n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    for (std::size_t len=2; len<=n; len<<=1) {
+        real ang = real(2) * kPi / real(len) * (inverse ? real(1) : real(-1));
+        std::complex<real> wl(std::cos(ang), std::sin(ang));
+        for (std::size_t i=0; i<n; i+=len) {
+            std::complex<real> w(1);
+            for (std::size_t j=0; j<len/2; ++j) {
+                std::complex<real> u = a[i+j], v = a[i+j+len/2] * w;
+                a[i+j] = u + v; a[i+j+len/2] = u - v;
+                w *= wl;
+            }
+        }
+    }
+}
+
+inline void fft_axis(std::vector<std::complex<real>>& A, std::size_t nx, std::size_t ny, std::size_t nz,
+                     int axis, bool inverse, unsigned threads) {
+    const std::size_t n  = axis == 0 ? nx : (axis == 1 ? ny : nz);
+    const std::size_t st = axis == 0 ? 1 : (axis == 1 ? nx : nx*ny);
+    const std::size_t lines = A.size() / n;
+    rslm::par::parallel_for(lines, [&](std::size_t b, std::size_t e) {
+        std::vector<std::complex<real>> buf(n);
+        for (std::size_t ln=b; ln<e; ++ln) {
+            std::size_t base;
+            if (axis == 0)      base = ln * nx;
+            else if (axis == 1) base = (ln / nx) * nx * ny + (ln % nx);
+            else                base = ln;
+            for (std::size_t q=0;q<n;++q) buf[q] = A[base + q*st];
+            fft(buf.data(), n, inverse);
+            for (std::size_t q=0;q<n;++q) A[base + q*st] = buf[q];
+        }
+    }, threads, 8);
+}
+
+inline bool pow2(std::size_t n) { return n >= 1 && (n & (n - 1)) == 0; }
+inline bool pow2p1(std::size_t n) { return n >= 3 && pow2(n - 1); }
+
+} // namespace detail
+
+/**
+ * ρ on lattice L (geometry taken from L, values overwritten) from events at
+ * time t0. The CIC splat is divided by h³ only when sigma <= 0 (point masses);
+ * with sigma > 0 the lattice holds the kernel sum directly, as T_{μν} does.
+ */
+inline void density_from_events(Lattice3& L, const std::vector<Event>& evs, const TSParams& P,
+                                real t0, PoissonBC bc, real truncate = real(4), unsigned threads = 0)
+{
+    std::fill(L.v.begin(), L.v.end(), real(0));
+    if (L.v.empty()) return;
+    const bool periodic = bc == PoissonBC::kPeriodic;
+    const bool smooth = P.sigma > 0;
+    const real inv2s2 = smooth ? real(0.5) / (P.sigma*P.sigma) : real(0);
+    const real cellw = smooth ? real(1) : real(1) / (L.h*L.h*L.h);
+    const long n[3] = { long(L.nx), long(L.ny), long(L.nz) };
+
+    for (const Event& e : evs) {
+        real dt = e.x.v[0] - t0;
+        real q = t00_flat(e, P) * std::exp(-dt*dt*inv2s2) * cellw;
+        real f[3] = { (e.x.v[1] - L.x0) / L.h, (e.x.v[2] - L.y0) / L.h, (e.x.v[3] - L.z0) / L.h };
+        long c[3]; real a[3];
+        bool inside = true;
+        for (int d=0; d<3; ++d) {
+            real fl = std::floor(f[d]);
+            c[d] = long(fl); a[d] = f[d] - fl;
+            if (!periodic && (c[d] < 0 || c[d] + 1 >= n[d])) inside = false;
+        }
+        if (!inside) continue;
+        for (int dz=0; dz<2; ++dz)
+            for (int dy=0; dy<2; ++dy)
+                for (int dx=0; dx<2; ++dx) {
+                    long ii = c[0] + dx, jj = c[1] + dy, kk = c[2] + dz;
+                    if (periodic) { ii = ((ii % n[0]) + n[0]) % n[0]; jj = ((jj % n[1]) + n[1]) % n[1]; kk = ((kk % n[2]) + n[2]) % n[2]; }
+                    real w = (dx ? a[0] : 1 - a[0]) * (dy ? a[1] : 1 - a[1]) * (dz ? a[2] : 1 - a[2]);
+                    L.at(std::size_t(ii), std::size_t(jj), std::size_t(kk)) += w * q;
+                }
+    }
+    if (smooth) {
+        const std::vector<real> taps = gauss_taps(P.sigma, L.h, truncate);
+        for (int axis=0; axis<3; ++axis) detail::blur_axis(L, axis, taps, periodic, threads);
+    }
+}
+
+// Periodic solve: V = 4πG (ρ - ⟨ρ⟩) / λ_k with λ_k the 7-point Laplacian symbol.
+inline bool solve_poisson_fft(const Lattice3& rho, Lattice3& V, real G = real(1), unsigned threads = 0) {
+    using detail::pow2;
+    if (!pow2(rho.nx) || !pow2(rho.ny) || !pow2(rho.nz)) {
+        TRACE_WARN("poisson_fft_bad_dims", rho.nx * 1000000 + rho.ny * 1000 + rho.nz);
+        return false;
+    }
+    const std::size_t nx = rho.nx, ny = rho.ny, nz = rho.nz;
+    std::vector<std::complex<real>> A(rho.v.begin(), rho.v.end());
+    for (int ax=0; ax<3; ++ax) detail::fft_axis(A, nx, ny, nz, ax, false, threads);
+
+    auto sym = [&](std::size_t k, std::size_t n) {
+        real s = std::sin(kPi * real(k) / real(n));
+        return real(-4) * s * s / (rho.h * rho.h);
+    };
+    std::vector<real> lx(nx), ly(ny), lz(nz);
+    for (std::size_t i=0;i<nx;++i) lx[i] = sym(i, nx);
+    for (std::size_t j=0;j<ny;++j) ly[j] = sym(j, ny);
+    for (std::size_t k=0;k<nz;++k) lz[k] = sym(k, nz);
+    const real src = real(4) * kPi * G;
+    for (std::size_t k=0;k<nz;++k)
+        for (std::size_t j=0;j<ny;++j)
+            for (std::size_t i=0;i<nx;++i) {
+                std::size_t q = (k*ny + j)*nx + i;
+                real lam = lx[i] + ly[j] + lz[k];
+                A[q] = (q == 0) ? std::complex<real>(0) : A[q] * (src / lam);
+            }
+
+    for (int ax=0; ax<3; ++ax) detail::fft_axis(A, nx, ny, nz, ax, true, threads);
+    V = like(rho);
+    const real inv = real(1) / real(nx*ny*nz);
+    for (std::size_t q=0;q<A.size();++q) V.v[q] = A[q].real() * inv;
+    return true;
+}
+
+// Total mass M = Σρ h³ and the |ρ|-weighted center (t component 0)
+inline void monopole(const Lattice3& rho, real& M, vec4& center) {
+    const real h3 = rho.h * rho.h * rho.h;
+    long double m = 0, ma = 0, cx = 0, cy = 0, cz = 0;
+    for (std::size_t k=0;k<rho.nz;++k)
+        for (std::size_t j=0;j<rho.ny;++j)
+            for (std::size_t i=0;i<rho.nx;++i) {
+                long double q = (long double)rho.at(i,j,k) * h3, aq = std::fabs(q);
+                m += q; ma += aq;
+                cx += aq * (rho.x0 + real(i)*rho.h);
+                cy += aq * (rho.y0 + real(j)*rho.h);
+                cz += aq * (rho.z0 + real(k)*rho.h);
+            }
+    if (ma > 0) { cx /= ma; cy /= ma; cz /= ma; }
+    M = real(m);
+    center = vec4(0, real(cx), real(cy), real(cz));
+}
+
+struct MultigridReport {
+    std::size_t cycles{0};
+    real rel_residual{0};       // ‖f - ∇²V‖∞ / ‖f‖∞ on interior vertices
+};
+
+namespace detail {
+
+// 7-point residual r = f - ∇²V on interior vertices (boundary r = 0)
+inline void mg_residual(const Lattice3& V, const Lattice3& f, Lattice3& r) {
+    const real ih2 = real(1) / (V.h*V.h);
+    const std::size_t sx = 1, sy = V.nx, sz = V.nx*V.ny;
+    std::fill(r.v.begin(), r.v.end(), real(0));
+    for (std::size_t k=1;k+1<V.nz;++k)
+        for (std::size_t j=1;j+1<V.ny;++j)
+            for (std::size_t i=1;i+1<V.nx;++i) {
+                std::size_t q = V.idx(i,j,k);
+                real lap = (V.v[q-sx] + V.v[q+sx] + V.v[q-sy] + V.v[q+sy] + V.v[q-sz] + V.v[q+sz] - real(6)*V.v[q]) * ih2;
+                r.v[q] = f.v[q] - lap;
+            }
+}
+
+// Red-black Gauss–Seidel sweeps on interior vertices
+inline void mg_smooth(Lattice3& V, const Lattice3& f, int sweeps) {
+    const real h2 = V.h*V.h;
+    const std::size_t sx = 1, sy = V.nx, sz = V.nx*V.ny;
+    for (int s=0; s<sweeps; ++s)
+        for (std::size_t color=0; color<2; ++color)
+            for (std::size_t k=1;k+1<V.nz;++k)
+                for (std::size_t j=1;j+1<V.ny;++j)
+                    for (std::size_t i=1 + ((j + k + 1 + color) & 1); i+1<V.nx; i+=2) {
+                        std::size_t q = V.idx(i,j,k);
+                        V.v[q] = (V.v[q-sx] + V.v[q+sx] + V.v[q-sy] + V.v[q+sy] + V.v[q-sz] + V.v[q+sz] - h2*f.v[q]) / real(6);
+                    }
+}
+
+inline Lattice3 mg_coarse_of(const Lattice3& L) {
+    Lattice3 c;
+    c.x0 = L.x0; c.y0 = L.y0; c.z0 = L.z0; c.h = L.h * 2;
+    c.resize((L.nx - 1)/2 + 1, (L.ny - 1)/2 + 1, (L.nz - 1)/2 + 1);
+    return c;
+}
+
+// Full weighting (1/4, 1/2, 1/4)³ of interior coarse vertices
+inline void mg_restrict(const Lattice3& r, Lattice3& c) {
+    std::fill(c.v.begin(), c.v.end(), real(0));
+    const real w[3] = { real(0.25), real(0.5), real(0.25) };
+    for (std::size_t K=1;K+1<c.nz;++K)
+        for (std::size_t J=1;J+1<c.ny;++J)
+            for (std::size_t I=1;I+1<c.nx;++I) {
+                real s = 0;
+                for (int dz=-1;dz<=1;++dz)
+                    for (int dy=-1;dy<=1;++dy)
+                        for (int dx=-1;dx<=1;++dx)
+                            s += w[dx+1]*w[dy+1]*w[dz+1] * r.at(2*I + dx, 2*J + dy, 2*K + dz);
+                c.at(I,J,K) = s;
+            }
+}
+
+// V += trilinear prolongation of the coarse correction e
+inline void mg_prolong_add(const Lattice3& e, Lattice3& V) {
+    for (std::size_t k=1;k+1<V.nz;++k)
+        for (std::size_t j=1;j+1<V.ny;++j)
+            for (std::size_t i=1;i+1<V.nx;++i) {
+                std::size_t I = i/2, J = j/2, K = k/2;
+                std::size_t I1 = I + (i & 1), J1 = J + (j & 1), K1 = K + (k & 1);
+                real s = e.at(I,J,K) + e.at(I1,J,K) + e.at(I,J1,K) + e.at(I1,J1,K)
+                       + e.at(I,J,K1) + e.at(I1,J,K1) + e.at(I,J1,K1) + e.at(I1,J1,K1);
+                V.at(i,j,k) += s * real(0.125);
+            }
+}
+
+inline void mg_vcycle(Lattice3& V, const Lattice3& f, int pre, int post) {
+    const bool coarsest = V.nx < 5 || V.ny < 5 || V.nz < 5 ||
+                          !pow2p1(V.nx) || !pow2p1(V.ny) || !pow2p1(V.nz);
+    if (coarsest) { mg_smooth(V, f, 64); return; }
+    mg_smooth(V, f, pre);
+    Lattice3 r = like(V);
+    mg_residual(V, f, r);
+    Lattice3 fc = mg_coarse_of(V);
+    mg_restrict(r, fc);
+    Lattice3 ec = like(fc);
+    mg_vcycle(ec, fc, pre, post);
+    mg_prolong_add(ec, V);
+    mg_smooth(V, f, post);
+}
+
+} // namespace detail
+
+/**
+ * Isolated solve on dims 2^k + 1 (each axis). The boundary is fixed to the
+ * monopole -G·M/|x - x_cm| of ρ (M = Σρ h³), interior starts from zero.
+ */
+inline bool solve_poisson_mg(const Lattice3& rho, Lattice3& V, real G = real(1),
+                             real tol = real(1e-8), std::size_t max_cycles = 50,
+                             MultigridReport* rep = nullptr)
+{
+    using detail::pow2p1;
+    if (!pow2p1(rho.nx) || !pow2p1(rho.ny) || !pow2p1(rho.nz)) {
+        TRACE_WARN("poisson_mg_bad_dims", rho.nx * 1000000 + rho.ny * 1000 + rho.nz);
+        return false;
+    }
+    real M; vec4 cm;
+    monopole(rho, M, cm);
+    const real cx = cm.v[1], cy = cm.v[2], cz = cm.v[3];
+
+    V = like(rho);
+    Lattice3 f = like(rho);
+    const real src = real(4) * kPi * G;
+    for (std::size_t q=0;q<f.v.size();++q) f.v[q] = src * rho.v[q];
+    for (std::size_t k=0;k<V.nz;++k)
+        for (std::size_t j=0;j<V.ny;++j)
+            for (std::size_t i=0;i<V.nx;++i) {
+                if (i && j && k && i+1<V.nx && j+1<V.ny && k+1<V.nz) continue;
+                real dx = rho.x0 + real(i)*rho.h - cx, dy = rho.y0 + real(j)*rho.h - cy, dz = rho.z0 + real(k)*rho.h - cz;
+                real rr = std::sqrt(dx*dx + dy*dy + dz*dz);
+                V.at(i,j,k) = rr > 0 ? -G * M / rr : real(0);
+            }
+
+    real fmax = 0;
+    for (real x : f.v) fmax = std::max(fmax, std::fabs(x));
+    Lattice3 r = like(rho);
+    MultigridReport R;
+    for (R.cycles=0; R.cycles<max_cycles; ) {
+        detail::mg_vcycle(V, f, 2, 2);
+        ++R.cycles;
+        detail::mg_residual(V, f, r);
+        real rmax = 0;
+        for (real x : r.v) rmax = std::max(rmax, std::fabs(x));
+        R.rel_residual = fmax > 0 ? rmax / fmax : rmax;
+        if (R.rel_residual <= tol) break;
+    }
+    TRACE_DEBUG("poisson_mg_cycles", R.cycles);
+    if (rep) *rep = R;
+    return true;
+}
+
+class LatticePotential final : public IPotential {
+public:
+    LatticePotential() = default;
+    LatticePotential(Lattice3 V, PoissonBC bc, real G = real(1), real mass = real(0), vec4 center = vec4{0,0,0,0})
+        : L_(std::move(V)), bc_(bc), GM_(G * mass), c_(center) {}
+
+    const Lattice3& lattice() const { return L_; }
+
+    real V(const vec4& x) const override { real v; vec4 g; eval(x, v, g, false); return v; }
+
+    // Gradient of the tricubic interpolant (∂_t V = 0); h is unused.
+    vec4 grad(const vec4& x, real) const override { real v; vec4 g; eval(x, v, g, true); return g; }
+
+private:
+    // Catmull-Rom weights and their derivatives at fraction t
+    static void cr(real t, real w[4], real dw[4]) {
+        real t2 = t*t, t3 = t2*t;
+        w[0] = real(0.5) * (-t3 + 2*t2 - t);
+        w[1] = real(0.5) * (3*t3 - 5*t2 + 2);
+        w[2] = real(0.5) * (-3*t3 + 4*t2 + t);
+        w[3] = real(0.5) * (t3 - t2);
+        dw[0] = real(0.5) * (-3*t2 + 4*t - 1);
+        dw[1] = real(0.5) * (9*t2 - 10*t);
+        dw[2] = real(0.5) * (-9*t2 + 8*t + 1);
+        dw[3] = real(0.5) * (3*t2 - 2*t);
+    }
+
+    void eval(const vec4& x, real& v, vec4& g, bool want_grad) const {
+        v = 0; g = vec4{0,0,0,0};
+        if (L_.v.empty()) return;
+        const bool periodic = bc_ == PoissonBC::kPeriodic;
+        const std::size_t n[3] = { L_.nx, L_.ny, L_.nz };
+        real f[3] = { (x.v[1] - L_.x0) / L_.h, (x.v[2] - L_.y0) / L_.h, (x.v[3] - L_.z0) / L_.h };
+        if (!periodic) {
+            bool outside = false;
+            for (int d=0; d<3; ++d) outside |= !(f[d] >= 0 && f[d] <= real(n[d] - 1));
+            if (outside) {                                   // monopole tail
+                real d[3] = { x.v[1] - c_.v[1], x.v[2] - c_.v[2], x.v[3] - c_.v[3] };
+                real r2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2], r = std::sqrt(r2);
+                if (r > 0) {
+                    v = -GM_ / r;
+                    for (int a=0;a<3;++a) g.v[a+1] = GM_ * d[a] / (r2 * r);
+                }
+                return;
+            }
+        }
+        long c[3]; real w[3][4], dw[3][4];
+        for (int d=0; d<3; ++d) {
+            real fl = std::floor(f[d]);
+            if (!periodic) fl = std::min(fl, real(n[d] - 2));   // x at the far face
+            c[d] = long(fl);
+            cr(f[d] - fl, w[d], dw[d]);
+        }
+        auto node = [&](long q, int d) {
+            long nn = long(n[d]);
+            if (periodic) return std::size_t(((q % nn) + nn) % nn);
+            return std::size_t(std::clamp(q, 0L, nn - 1));    // edge clamp for the outer taps
+        };
+        real gx = 0, gy = 0, gz = 0;
+        for (int kz=0; kz<4; ++kz) {
+            std::size_t K = node(c[2] + kz - 1, 2);
+            for (int ky=0; ky<4; ++ky) {
+                std::size_t J = node(c[1] + ky - 1, 1);
+                for (int kx=0; kx<4; ++kx) {
+                    real s = L_.at(node(c[0] + kx - 1, 0), J, K);
+                    v += w[0][kx] * w[1][ky] * w[2][kz] * s;
+                    if (want_grad) {
+                        gx += dw[0][kx] * w[1][ky] * w[2][kz] * s;
+                        gy += w[0][kx] * dw[1][ky] * w[2][kz] * s;
+                        gz += w[0][kx] * w[1][ky] * dw[2][kz] * s;
+                    }
+                }
+            }
+        }
+        const real ih = real(1) / L_.h;
+        g.v[1] = gx * ih; g.v[2] = gy * ih; g.v[3] = gz * ih;
+    }
+
+    Lattice3 L_;
+    PoissonBC bc_{PoissonBC::kIsolated};
+    real GM_{0};
+    vec4 c_{0,0,0,0};
+};
+
+/**
+ * Events → ρ → V → LatticePotential on an n³-vertex box [lo, lo + (n-1)h]³.
+ * Periodic boxes need n = 2^k, isolated boxes n = 2^k + 1; false on failure.
+ */
+inline bool make_lattice_potential(const std::vector<Event>& evs, const TSParams& P, real t0,
+                                   const vec4& lo, real h, std::size_t n, PoissonBC bc,
+                                   LatticePotential& out, real G = real(1), unsigned threads = 0)
+{
+    Lattice3 rho;
+    rho.x0 = lo.v[1]; rho.y0 = lo.v[2]; rho.z0 = lo.v[3]; rho.h = h;
+    rho.resize(n, n, n);
+    density_from_events(rho, evs, P, t0, bc, real(4), threads);
+
+    Lattice3 V;
+    bool ok = bc == PoissonBC::kPeriodic ? solve_poisson_fft(rho, V, G, threads)
+                                         : solve_poisson_mg(rho, V, G);
+    if (!ok) return false;
+
+    real M; vec4 cm;
+    monopole(rho, M, cm);
+    out = LatticePotential(std::move(V), bc, G, M, cm);
+    return true;
+}
+
+} // namespace rslm::phys
@@ -23,6 +23,7 @@
 
 #include "units.hpp"
 #include "config.hpp"
+#include "types.hpp"
 #include "linalg.hpp"
 #include "metric.hpp"
 #include "quadform.hpp"
@@ -38,19 +39,7 @@ using rslm::linalg::sym4;
 using rslm::field::IMetricField;
 using rslm::units::real;
 
-struct Event {
-    vec4 x;     // position (t,x,y,z)
-    vec4 u;     // 4-velocity (approximately timelike, not required normalized)
-    real E{1};  // semantic energy ≥ 0
-    real m{1};  // “rest mass” > 0
-};
-
-struct TSParams {
-    real sigma{1.0};   // kernel width
-    real eta{1e-2};    // stabilizer for g-term
-    real kappa{0.1};   // coupling constant
-    real c2{1.0};
-};
+// Event {x, u, E, m} and TSParams {sigma, eta, kappa, c2} are declared in types.hpp.
 
 inline mat4 lower_u_outer(const sym4& g, const vec4& u) {
     // u_mu = g_{μa} u^a ; return u_mu u_nu outer product
@@ -0,0 +1,137 @@
+#pragma once
+/**
+ * RSLM Maths — qmc.hpp
+ * --------------------
+ * Scrambled low-discrepancy sequences on [0,1)^d, d ≤ 8, random-access by index:
+ *  - Sobol  : Joe–Kuo direction numbers, Owen (nested uniform) scrambling via
+ *             the Laine–Karras hash on bit-reversed values
+ *  - Halton : prime bases 2..19, independent random digit permutations per
+ *             dimension and digit position
+ * seed = 0 gives the plain (unscrambled) sequence. Different seeds give
+ * independent randomizations, which is what replicate error estimates need.
+ * Sobol is balanced on blocks of 2^m consecutive indices; draw it in
+ * power-of-two sizes.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+#include "config.hpp"
+#include "rng.hpp"
+
+namespace rslm::rng {
+
+using rslm::cfg::real;
+
+inline std::uint32_t reverse_bits32(std::uint32_t x) {
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+    x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+// Owen scramble of a 32-bit fixed-point coordinate (Burley 2020): each bit is
+// flipped by a hash of the bits above it.
+inline std::uint32_t owen_scramble32(std::uint32_t x, std::uint32_t seed) {
+    x = reverse_bits32(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return reverse_bits32(x);
+}
+
+// 32-bit fixed point → [0,1), strictly below 1 for float builds too
+inline real fixed_to_unit(std::uint32_t x) {
+    const real u = real((double(x) + 0.5) * (1.0 / 4294967296.0));
+    return std::min(u, std::nextafter(real(1), real(0)));
+}
+
+struct Sobol {
+    static constexpr int kMaxDim = 8;
+
+    explicit Sobol(int dim = 1, std::uint64_t seed = 0) : dim_(std::clamp(dim, 1, kMaxDim)) {
+        // Joe–Kuo (new-joe-kuo-6.21201), dimensions 2..8: degree s, poly a, initial m
+        static constexpr int S[kMaxDim]      = {0, 1, 2, 3, 3, 4, 4, 5};
+        static constexpr int A[kMaxDim]      = {0, 0, 1, 1, 2, 1, 4, 2};
+        static constexpr int M[kMaxDim][5]   = {{0}, {1}, {1,3}, {1,3,1}, {1,1,1}, {1,1,3,3}, {1,3,5,13}, {1,1,5,5,17}};
+        for (int d=0; d<dim_; ++d) {
+            std::uint32_t* V = v_[d];
+            if (d == 0) { for (int k=0;k<32;++k) V[k] = 1u << (31 - k); continue; }
+            const int s = S[d], a = A[d];
+            for (int k=0;k<s;++k) V[k] = std::uint32_t(M[d][k]) << (31 - k);
+            for (int k=s;k<32;++k) {
+                V[k] = V[k-s] ^ (V[k-s] >> s);
+                for (int j=1;j<s;++j) if ((a >> (s-1-j)) & 1) V[k] ^= V[k-j];
+            }
+        }
+        PCG32 g(seed, 0x5eedu);
+        for (int d=0; d<kMaxDim; ++d) seed_[d] = seed ? g.next_u32() : 0u;
+        scrambled_ = seed != 0;
+    }
+
+    int dim() const { return dim_; }
+
+    // Point `i` of the sequence, u[0..dim)
+    void point(std::uint32_t i, real* u) const {
+        for (int d=0; d<dim_; ++d) {
+            std::uint32_t x = 0;
+            for (std::uint32_t k=0, b=i; b; ++k, b >>= 1) if (b & 1u) x ^= v_[d][k];
+            if (scrambled_) x = owen_scramble32(x, seed_[d]);
+            u[d] = fixed_to_unit(x);
+        }
+    }
+
+private:
+    int dim_;
+    bool scrambled_{false};
+    std::uint32_t v_[kMaxDim][32]{};
+    std::uint32_t seed_[kMaxDim]{};
+};
+
+struct Halton {
+    static constexpr int kMaxDim = 8;
+    static constexpr int kMaxDigits = 32;              // base 2 needs 32 digits for 32-bit indices
+
+    explicit Halton(int dim = 1, std::uint64_t seed = 0) : dim_(std::clamp(dim, 1, kMaxDim)) {
+        static constexpr int P[kMaxDim] = {2, 3, 5, 7, 11, 13, 17, 19};
+        PCG32 g(seed, 0x4a17u);
+        for (int d=0; d<dim_; ++d) {
+            base_[d] = P[d];
+            ndig_[d] = int(std::ceil(32 * std::log(2.0) / std::log(double(P[d]))));
+            for (int k=0;k<ndig_[d];++k) {
+                std::uint8_t* p = perm_[d][k];
+                for (int j=0;j<base_[d];++j) p[j] = std::uint8_t(j);
+                if (!seed) continue;
+                for (int j=base_[d]-1; j>0; --j) std::swap(p[j], p[g.next_u32() % std::uint32_t(j + 1)]);
+            }
+        }
+    }
+
+    int dim() const { return dim_; }
+
+    void point(std::uint32_t i, real* u) const {
+        for (int d=0; d<dim_; ++d) {
+            const int b = base_[d];
+            const double inv = 1.0 / double(b);
+            double f = inv, x = 0;
+            std::uint32_t n = i;
+            for (int k=0;k<ndig_[d];++k, f *= inv) {
+                x += perm_[d][k][n % std::uint32_t(b)] * f;
+                n /= std::uint32_t(b);
+            }
+            u[d] = std::min(real(x), std::nextafter(real(1), real(0)));
+        }
+    }
+
+private:
+    int dim_;
+    int base_[kMaxDim]{}, ndig_[kMaxDim]{};
+    std::uint8_t perm_[kMaxDim][kMaxDigits][19]{};
+};
+
+} // namespace rslm::rng
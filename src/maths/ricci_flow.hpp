@@ -0,0 +1,307 @@
+#pragma once
+/**
+ * RSLM Maths — ricci_flow.hpp
+ * ---------------------------
+ * Ricci-flow smoothing of a LatticeMetricField, stepped on its SoA coefficients:
+ *
+ *   ∂_t g_{ij} = -2 R_{ij} + ∇_i W_j + ∇_j W_i,   W_j = g^{pq} Γ_{j,pq}
+ *
+ * The W terms (DeTurck, flat background) make the flow strictly parabolic:
+ * its principal part is g^{ab} ∂_a∂_b g_{ij}, so spikes diffuse instead of
+ * steepening. Without them (deturck = false) this is plain -2 Ric. The field
+ * is static, so only spatial derivatives enter and the diffusivity is the
+ * spatial block of g⁻¹.
+ *
+ * The right-hand side is evaluated at each node from the spline's closed-form
+ * jet (riemann_from_jet, no FD stencils) and applied to that node's coefficient.
+ *  - explicit  : c += dt · rhs, dt ≤ h² / (6 ν) with ν ≥ λ_max(g^{ab})
+ *  - implicit  : linearly implicit in the principal part,
+ *                (1 - dt ν Δ_h) c' = c + dt (rhs - ν Δ_h c)
+ *                with Δ_h the 7-point coefficient Laplacian (clamped faces),
+ *                one CG solve per component; stable for large dt
+ * Both run over node blocks in parallel. Afterwards nodes whose coefficient
+ * metric η + c leaves the cone {g_tt < 0, spatial block PD} are projected with
+ * metric::project_signature; that cone is convex, so when every node is inside
+ * it the spline metric is Lorentzian everywhere. Other nodes are not touched.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "config.hpp"
+#include "types.hpp"
+#include "linalg.hpp"
+#include "linalg_batch.hpp"
+#include "connection.hpp"
+#include "curvature.hpp"
+#include "lattice_field.hpp"
+#include "metric.hpp"
+#include "parallel.hpp"
+#include "trace.hpp"
+
+namespace rslm::curv {
+
+using rslm::linalg::sym4;
+using rslm::linalg::Sym4Batch;
+using rslm::linalg::sym_idx;
+using rslm::field::LatticeMetricField;
+
+struct RicciFlowOptions {
+    real dt{0};                 // 0 → half the explicit stability limit
+    bool deturck{true};
+    bool implicit{false};
+    std::size_t cg_iters{200};  // implicit only
+    real cg_tol{real(1e-10)};
+    unsigned threads{0};
+};
+
+struct RicciFlowReport {
+    std::size_t steps{0}, projected{0}, cg_total{0};
+    real dt{0};
+    real max_rate{0};           // max_n ‖rhs_n‖_F of the last step
+};
+
+// Flow right-hand side at jet (g, ∂g, ∂∂g); ∂_t entries of the jet are zero.
+inline mat4 ricci_flow_rhs(const MetricPack& M, const rslm::deriv::DDMetric4& dd, bool deturck) {
+    mat4 Rc = ricci(riemann_from_jet(M, dd));
+    mat4 out;
+    for (int i=0;i<4;++i) for (int j=0;j<4;++j) out.m[i][j] = -(Rc.m[i][j] + Rc.m[j][i]);
+    if (!deturck) return out;
+
+    const auto& gi = M.g_inv.m;
+    // Γ_{j,pq} (first kind) and ∂_a g^{pq} = -(g⁻¹ ∂_a g g⁻¹)^{pq}
+    real G1[4][4][4], dginv[4][4][4];
+    for (int j=0;j<4;++j)
+        for (int p=0;p<4;++p)
+            for (int q=0;q<4;++q)
+                G1[j][p][q] = real(0.5) * (M.dg.dg[p].m[j][q] + M.dg.dg[q].m[j][p] - M.dg.dg[j].m[p][q]);
+    for (int a=0;a<4;++a) {
+        real t[4][4];
+        for (int p=0;p<4;++p) for (int q=0;q<4;++q) { real s = 0; for (int k=0;k<4;++k) s += gi[p][k] * M.dg.dg[a].m[k][q]; t[p][q] = s; }
+        for (int p=0;p<4;++p) for (int q=0;q<4;++q) { real s = 0; for (int k=0;k<4;++k) s += t[p][k] * gi[k][q]; dginv[a][p][q] = -s; }
+    }
+    real W[4], dW[4][4];                            // W_j, ∂_a W_j
+    for (int j=0;j<4;++j) {
+        real s = 0;
+        for (int p=0;p<4;++p) for (int q=0;q<4;++q) s += gi[p][q] * G1[j][p][q];
+        W[j] = s;
+    }
+    for (int a=0;a<4;++a)
+        for (int j=0;j<4;++j) {
+            real s = 0;
+            for (int p=0;p<4;++p)
+                for (int q=0;q<4;++q) {
+                    const real dG = real(0.5) * (dd.ddg[a][p].m[j][q] + dd.ddg[a][q].m[j][p] - dd.ddg[a][j].m[p][q]);
+                    s += dginv[a][p][q] * G1[j][p][q] + gi[p][q] * dG;
+                }
+            dW[a][j] = s;
+        }
+    // ∇_i W_j = ∂_i W_j - Γ^k_{ij} W_k,  Γ^k_{ij} W_k = Γ_{l,ij} W^l
+    real Wu[4];
+    for (int l=0;l<4;++l) { real s = 0; for (int k=0;k<4;++k) s += gi[l][k] * W[k]; Wu[l] = s; }
+    for (int i=0;i<4;++i)
+        for (int j=0;j<4;++j) {
+            real GW = 0;
+            for (int l=0;l<4;++l) GW += G1[l][i][j] * Wu[l];
+            out.m[i][j] += dW[i][j] + dW[j][i] - 2 * GW;
+        }
+    return out;
+}
+
+// rhs at every node position, SoA (same layout as F.coeffs()); returns max ‖rhs‖_F.
+inline real ricci_flow_rhs(const LatticeMetricField& F, Sym4Batch& out, bool deturck = true, unsigned threads = 0) {
+    const std::size_t n = F.nodes();
+    out.resize(n);
+    std::vector<real> part(n, real(0));
+    rslm::par::parallel_for(n, [&](std::size_t b, std::size_t e) {
+        MetricPack M;
+        rslm::deriv::DDMetric4 dd;
+        for (std::size_t k=b;k<e;++k) {
+            F.jet(F.node_pos(k), M.g, M.dg, dd);
+            real det = 0, cond = 0;
+            M.inv_ok = rslm::linalg::inverse(M.g, M.g_inv, det, cond, real(1e-14));
+            if (!M.inv_ok) continue;                 // degenerate node: no flow
+            mat4 r = ricci_flow_rhs(M, dd, deturck);
+            out.set(k, r);
+            real s = 0;
+            for (int i=0;i<4;++i) for (int j=0;j<4;++j) s += r.m[i][j] * r.m[i][j];
+            part[k] = s;
+        }
+    }, threads, 32);
+    real mx = 0;
+    for (real v : part) mx = std::max(mx, v);
+    return std::sqrt(mx);
+}
+
+namespace detail {
+
+// η + c_k, the metric a single node contributes
+inline sym4 node_metric(const Sym4Batch& C, std::size_t k) {
+    sym4 g = C.get(k);
+    g.m[0][0] -= 1; g.m[1][1] += 1; g.m[2][2] += 1; g.m[3][3] += 1;
+    return g;
+}
+
+// y = x - s Δ_h x on the node lattice (clamped faces = zero-flux)
+inline void helmholtz_apply(const LatticeMetricField& F, real s, const real* x, real* y, unsigned threads) {
+    const std::size_t nx = F.nx(), ny = F.ny(), nz = F.nz();
+    const real w = s / (F.h() * F.h());
+    rslm::par::parallel_for(nz * ny, [&](std::size_t b, std::size_t e) {
+        for (std::size_t row=b; row<e; ++row) {
+            const std::size_t k = row / ny, j = row % ny, base = row * nx;
+            const std::size_t jm = (j ? j-1 : j), jp = (j+1 < ny ? j+1 : j);
+            const std::size_t km = (k ? k-1 : k), kp = (k+1 < nz ? k+1 : k);
+            const real* xjm = x + (k*ny + jm)*nx;  const real* xjp = x + (k*ny + jp)*nx;
+            const real* xkm = x + (km*ny + j)*nx;  const real* xkp = x + (kp*ny + j)*nx;
+            for (std::size_t i=0;i<nx;++i) {
+                const real c = x[base + i];
+                const real xm = x[base + (i ? i-1 : i)], xp = x[base + (i+1 < nx ? i+1 : i)];
+                const real lap = xm + xp + xjm[i] + xjp[i] + xkm[i] + xkp[i] - 6*c;
+                y[base + i] = c - w * lap;
+            }
+        }
+    }, threads, 8);
+}
+
+inline real dot(const std::vector<real>& a, const std::vector<real>& b) {
+    long double s = 0;
+    for (std::size_t k=0;k<a.size();++k) s += (long double)a[k] * b[k];
+    return real(s);
+}
+
+// Solve (1 - s Δ_h) x = rhs by CG (SPD); x holds the initial guess.
+inline std::size_t helmholtz_cg(const LatticeMetricField& F, real s, const std::vector<real>& rhs,
+                                std::vector<real>& x, std::size_t max_it, real tol, unsigned threads)
+{
+    const std::size_t n = rhs.size();
+    std::vector<real> r(n), p(n), Ap(n);
+    helmholtz_apply(F, s, x.data(), Ap.data(), threads);
+    for (std::size_t k=0;k<n;++k) { r[k] = rhs[k] - Ap[k]; p[k] = r[k]; }
+    real rr = dot(r, r);
+    const real stop = tol * tol * std::max(dot(rhs, rhs), real(1e-300));
+    std::size_t it = 0;
+    while (it < max_it && rr > stop) {
+        helmholtz_apply(F, s, p.data(), Ap.data(), threads);
+        const real alpha = rr / dot(p, Ap);
+        for (std::size_t k=0;k<n;++k) { x[k] += alpha * p[k]; r[k] -= alpha * Ap[k]; }
+        const real rr1 = dot(r, r);
+        const real beta = rr1 / rr;
+        rr = rr1;
+        for (std::size_t k=0;k<n;++k) p[k] = r[k] + beta * p[k];
+        ++it;
+    }
+    return it;
+}
+
+inline bool in_lorentz_cone(const sym4& g) {
+    const auto& m = g.m;
+    const real d1 = m[1][1];
+    const real d2 = m[1][1]*m[2][2] - m[1][2]*m[2][1];
+    const real d3 = m[1][1]*(m[2][2]*m[3][3] - m[2][3]*m[3][2])
+                  - m[1][2]*(m[2][1]*m[3][3] - m[2][3]*m[3][1])
+                  + m[1][3]*(m[2][1]*m[3][2] - m[2][2]*m[3][1]);
+    return m[0][0] < 0 && d1 > 0 && d2 > 0 && d3 > 0;
+}
+
+} // namespace detail
+
+// ν = max over nodes of a Gershgorin bound on λ_max of the spatial block of (η + c)⁻¹
+inline real ricci_flow_diffusivity(const LatticeMetricField& F) {
+    real nu = 0;
+    const Sym4Batch& C = F.coeffs();
+    for (std::size_t k=0;k<C.n;++k) {
+        const sym4 g = detail::node_metric(C, k);
+        mat4 gi; real det = 0, cond = 0;
+        if (!rslm::linalg::inverse(g, gi, det, cond, real(1e-14))) continue;
+        for (int a=1;a<4;++a) {
+            real s = 0;
+            for (int b=1;b<4;++b) s += std::fabs(gi.m[a][b]);
+            nu = std::max(nu, s);
+        }
+    }
+    return nu > 0 ? nu : real(1);
+}
+
+// Largest stable explicit step (forward Euler on the principal part)
+inline real ricci_flow_stable_dt(const LatticeMetricField& F) {
+    return F.h() * F.h() / (6 * ricci_flow_diffusivity(F));
+}
+
+/**
+ * One flow step on F's coefficients. Returns false (F unchanged) if the step
+ * produced non-finite values.
+ */
+inline bool ricci_flow_step(LatticeMetricField& F, const RicciFlowOptions& opt = {}, RicciFlowReport* rep = nullptr) {
+    Sym4Batch& C = F.coeffs();
+    const std::size_t n = C.n;
+    if (n == 0) return true;
+    const real nu = ricci_flow_diffusivity(F);
+    const real dt = opt.dt > 0 ? opt.dt : real(0.5) * F.h() * F.h() / (6 * nu);
+
+    Sym4Batch rhs;
+    const real rate = ricci_flow_rhs(F, rhs, opt.deturck, opt.threads);
+    if (!std::isfinite(rate)) { TRACE_WARN("ricci_flow_nonfinite", rate); return false; }
+
+    Sym4Batch next = C;
+    std::size_t cg_total = 0;
+    if (!opt.implicit) {
+        for (int p=0;p<10;++p) {
+            real* c = next.c[p].data(); const real* r = rhs.c[p].data();
+            rslm::par::parallel_for(n, [&](std::size_t b, std::size_t e) {
+                RSLM_VECTORIZE
+                for (std::size_t k=b;k<e;++k) c[k] += dt * r[k];
+            }, opt.threads, 4096);
+        }
+    } else {
+        const real s = dt * nu;
+        std::vector<real> b(n), Lc(n);
+        for (int p=0;p<10;++p) {
+            // b = c + dt·rhs - s Δ_h c = (1 - s Δ_h) c + dt·rhs
+            detail::helmholtz_apply(F, s, C.c[p].data(), Lc.data(), opt.threads);
+            for (std::size_t k=0;k<n;++k) b[k] = Lc[k] + dt * rhs.c[p][k];
+            cg_total += detail::helmholtz_cg(F, s, b, next.c[p], opt.cg_iters, opt.cg_tol, opt.threads);
+        }
+    }
+
+    // signature projection only on nodes that left the cone
+    std::vector<unsigned char> bad(n, 0);
+    rslm::par::parallel_for(n, [&](std::size_t b, std::size_t e) {
+        for (std::size_t k=b;k<e;++k) {
+            const sym4 g = detail::node_metric(next, k);
+            for (int r=0;r<4;++r) for (int c=0;c<4;++c) if (!std::isfinite(g.m[r][c])) { bad[k] = 2; break; }
+            if (bad[k] == 0 && !detail::in_lorentz_cone(g)) bad[k] = 1;
+        }
+    }, opt.threads, 256);
+    std::size_t projected = 0;
+    for (std::size_t k=0;k<n;++k) {
+        if (bad[k] == 2) { TRACE_WARN("ricci_flow_nonfinite_node", k); return false; }
+        if (bad[k] == 0) continue;
+        sym4 g = rslm::metric::project_signature(detail::node_metric(next, k));
+        g.m[0][0] += 1; g.m[1][1] -= 1; g.m[2][2] -= 1; g.m[3][3] -= 1;   // back to c = g - η
+        next.set(k, g);
+        ++projected;
+    }
+    C = std::move(next);
+
+    if (rep) {
+        ++rep->steps; rep->projected += projected; rep->cg_total += cg_total;
+        rep->dt = dt; rep->max_rate = rate;
+    }
+    if (projected) TRACE_DEBUG("ricci_flow_projected", projected);
+    return true;
+}
+
+// `steps` flow steps; stops early on failure.
+inline bool ricci_flow(LatticeMetricField& F, std::size_t steps, const RicciFlowOptions& opt = {},
+                       RicciFlowReport* rep = nullptr)
+{
+    RicciFlowReport R;
+    bool ok = true;
+    for (std::size_t s=0; s<steps && ok; ++s) ok = ricci_flow_step(F, opt, &R);
+    if (rep) *rep = R;
+    return ok;
+}
+
+} // namespace rslm::curv
@@ -0,0 +1,251 @@
+#pragma once
+/**
+ * RSLM Maths — shard.hpp
+ * ----------------------
+ * Multi-process sharding of grid sampling and trajectory integration (POSIX).
+ *  - shard_range(n, nshards, k)      : fixed, contiguous partition of [0, n)
+ *  - run_shards(nshards, work, out)  : fork one worker per shard; each returns
+ *                                      a byte payload over a Unix socketpair
+ *  - map_sharded(n, stride, nprocs, out, fn(b, e, T*))
+ *                                    : fill items [b, e) of out per shard
+ *  - sample_xy_sharded()             : Grid2D split into row slabs
+ *  - integrate_sharded()             : trajectories split by ID range
+ *
+ * Workers evaluate exactly the same per-cell / per-trajectory expressions as
+ * the in-process code, and the parent places every shard at its fixed offset,
+ * so merged results are bitwise identical to a single-process run for any
+ * shard count. Frames are {magic, shard, status, bytes} + payload, so any
+ * stream transport (e.g. a TCP socket to another node) can carry them;
+ * only the local fork/socketpair launcher is provided here.
+ *
+ * Workers disable telemetry (the parent owns the log file) and leave with
+ * _exit(). Failures return false and emit TRACE_WARN("shard_failed", k).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+#include <algorithm>
+
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "field.hpp"
+#include "integrators.hpp"
+#include "grid.hpp"
+#include "logger.hpp"
+#include "trace.hpp"
+
+namespace rslm::shard {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::field::IMetricField;
+using rslm::field::IPotential;
+using rslm::diag::Grid2D;
+
+using Bytes = std::vector<unsigned char>;
+
+struct Range { std::size_t begin{0}, end{0}; };
+
+inline Range shard_range(std::size_t n, std::size_t nshards, std::size_t k) {
+    return Range{ k * n / nshards, (k + 1) * n / nshards };
+}
+
+// ---- Framing ---------------------------------------------------------------------
+
+struct FrameHeader {
+    std::uint32_t magic;        // 'RSHD'
+    std::uint32_t shard;
+    std::uint32_t status;       // 0 = ok
+    std::uint32_t reserved;
+    std::uint64_t bytes;        // payload size
+};
+
+inline constexpr std::uint32_t kFrameMagic = 0x44485352u;
+
+inline bool write_all(int fd, const void* p, std::size_t n) {
+    auto* c = static_cast<const unsigned char*>(p);
+    while (n) {
+        ssize_t w = ::write(fd, c, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        c += w; n -= std::size_t(w);
+    }
+    return true;
+}
+
+inline bool read_all(int fd, void* p, std::size_t n) {
+    auto* c = static_cast<unsigned char*>(p);
+    while (n) {
+        ssize_t r = ::read(fd, c, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        c += r; n -= std::size_t(r);
+    }
+    return true;
+}
+
+inline bool send_frame(int fd, std::uint32_t shard, std::uint32_t status, const Bytes& payload) {
+    FrameHeader h{ kFrameMagic, shard, status, 0, payload.size() };
+    return write_all(fd, &h, sizeof(h)) && write_all(fd, payload.data(), payload.size());
+}
+
+inline bool recv_frame(int fd, std::uint32_t expect_shard, Bytes& payload) {
+    FrameHeader h{};
+    if (!read_all(fd, &h, sizeof(h))) return false;
+    if (h.magic != kFrameMagic || h.shard != expect_shard || h.status != 0) return false;
+    payload.resize(std::size_t(h.bytes));
+    return read_all(fd, payload.data(), payload.size());
+}
+
+// ---- Launcher --------------------------------------------------------------------
+
+/**
+ * Run work(k) -> Bytes for k in [0, nshards), each in its own forked process.
+ * out[k] receives shard k's payload (shard order, independent of finish order).
+ * Fork from a quiescent point: the child only runs work(k) and exits.
+ */
+template <typename Work>
+inline bool run_shards(std::size_t nshards, Work&& work, std::vector<Bytes>& out) {
+    out.assign(nshards, Bytes{});
+    std::vector<int> fds;
+    std::vector<pid_t> pids;
+    bool ok = true;
+
+    for (std::size_t k=0;k<nshards && ok;++k) {
+        int sv[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) { ok = false; break; }
+        pid_t pid = ::fork();
+        if (pid < 0) { ::close(sv[0]); ::close(sv[1]); ok = false; break; }
+        if (pid == 0) {
+            // worker
+            ::close(sv[0]);
+            for (int fd : fds) ::close(fd);
+            rslm::telemetry::Logger::instance().set_enabled(false);
+            Bytes payload;
+            std::uint32_t status = 0;
+            try { payload = work(k); }
+            catch (...) { status = 1; payload.clear(); }
+            bool sent = send_frame(sv[1], std::uint32_t(k), status, payload);
+            ::close(sv[1]);
+            ::_exit((sent && status == 0) ? 0 : 1);
+        }
+        ::close(sv[1]);
+        fds.push_back(sv[0]);
+        pids.push_back(pid);
+    }
+
+    // Read in shard order; other workers block on their own socket meanwhile.
+    for (std::size_t k=0;k<fds.size();++k) {
+        if (ok && !recv_frame(fds[k], std::uint32_t(k), out[k])) {
+            TRACE_WARN("shard_failed", k);
+            ok = false;
+        }
+        ::close(fds[k]);
+    }
+    for (std::size_t k=0;k<pids.size();++k) {
+        int st = 0;
+        while (::waitpid(pids[k], &st, 0) < 0 && errno == EINTR) {}
+        if (!WIFEXITED(st) || WEXITSTATUS(st) != 0) {
+            if (ok) TRACE_WARN("shard_failed", k);
+            ok = false;
+        }
+    }
+    if (!ok) out.clear();
+    return ok;
+}
+
+/**
+ * Fill out[0, n*stride) across nprocs processes, sharding the n items:
+ * fn(b, e, T* dst) writes items [b, e) (stride T's each) into dst[0, (e-b)*stride).
+ * T must be trivially copyable. nprocs <= 1 runs inline.
+ */
+template <typename T, typename Fn>
+inline bool map_sharded(std::size_t n, std::size_t stride, std::size_t nprocs, T* out, Fn&& fn) {
+    static_assert(std::is_trivially_copyable_v<T>, "map_sharded: T must be trivially copyable");
+    if (n == 0 || stride == 0) return true;
+    nprocs = std::max<std::size_t>(1, std::min(nprocs, n));
+    if (nprocs == 1) { fn(std::size_t(0), n, out); return true; }
+
+    std::vector<Bytes> parts;
+    bool ok = run_shards(nprocs, [&](std::size_t k) {
+        Range r = shard_range(n, nprocs, k);
+        std::vector<T> tmp((r.end - r.begin) * stride);
+        fn(r.begin, r.end, tmp.data());
+        Bytes b(tmp.size() * sizeof(T));
+        if (!b.empty()) std::memcpy(b.data(), tmp.data(), b.size());
+        return b;
+    }, parts);
+    if (!ok) return false;
+
+    for (std::size_t k=0;k<nprocs;++k) {
+        Range r = shard_range(n, nprocs, k);
+        if (parts[k].size() != (r.end - r.begin) * stride * sizeof(T)) {
+            TRACE_WARN("shard_failed", k);
+            return false;
+        }
+        if (!parts[k].empty()) std::memcpy(out + r.begin * stride, parts[k].data(), parts[k].size());
+    }
+    return true;
+}
+
+// ---- Grid sampling (row slabs) -----------------------------------------------------
+
+// Same lattice and cell order as diag::sample_xy; rows i (y) are split across processes.
+template <typename ScalarFn>
+inline bool sample_xy_sharded(Grid2D& G, const IMetricField& F, real t0, real z0,
+                              real x0, real y0, real dx, real dy,
+                              std::size_t nx, std::size_t ny,
+                              ScalarFn f, std::size_t nprocs)
+{
+    G = Grid2D{};
+    G.nx=nx; G.ny=ny; G.x0=x0; G.y0=y0; G.dx=dx; G.dy=dy; G.t0=t0; G.z0=z0;
+    G.val.assign(nx*ny, real(0));
+    return map_sharded(nx, ny, nprocs, G.val.data(), [&](std::size_t b, std::size_t e, real* dst) {
+        vec4 x(t0, x0, y0, z0);
+        for (std::size_t i=b;i<e;++i) {
+            x.v[2] = y0 + real(i)*dy;       // y row
+            for (std::size_t j=0;j<ny;++j) {
+                x.v[1] = x0 + real(j)*dx;   // x col
+                dst[(i-b)*ny + j] = f(F, x);
+            }
+        }
+    });
+}
+
+// ---- Trajectories (ID ranges) ------------------------------------------------------
+
+/**
+ * Advance trajectories [0, n) by `steps` geodesic steps, split by ID range
+ * across nprocs processes (each may still use threads_per_proc threads).
+ * x/u are updated in place only if every shard succeeded.
+ */
+inline bool integrate_sharded(const IMetricField& F, const IPotential* P,
+                              vec4* x, vec4* u, std::size_t n, real dtau, std::size_t steps,
+                              std::size_t nprocs, unsigned threads_per_proc = 1)
+{
+    // state[k] = {x_k, u_k}
+    std::vector<vec4> state(2*n);
+    for (std::size_t k=0;k<n;++k) { state[2*k] = x[k]; state[2*k+1] = u[k]; }
+
+    bool ok = map_sharded(n, 2, nprocs, state.data(), [&](std::size_t b, std::size_t e, vec4* dst) {
+        std::size_t m = e - b;
+        std::vector<vec4> xs(x + b, x + e), us(u + b, u + e);
+        for (std::size_t s=0;s<steps;++s)
+            rslm::integ::geodesic_step_batch(F, P, xs.data(), us.data(), m, dtau, threads_per_proc);
+        for (std::size_t k=0;k<m;++k) { dst[2*k] = xs[k]; dst[2*k+1] = us[k]; }
+    });
+    if (!ok) return false;
+    for (std::size_t k=0;k<n;++k) { x[k] = state[2*k]; u[k] = state[2*k+1]; }
+    return true;
+}
+
+} // namespace rslm::shard
@@ -0,0 +1,168 @@
+#pragma once
+/**
+ * RSLM Maths — traj_batch.hpp
+ * ---------------------------
+ * Trajectory bundles kept in spatial (Morton) order for cache reuse.
+ *  - morton3(ix, iy, iz) : 21-bit-per-axis Z-order key
+ *  - TrajectoryBatch     : SoA-ish lanes (x, u) + stable lane ↔ caller-ID maps;
+ *      sort_spatial()    : re-order active lanes by the Morton key of (x,y,z),
+ *                          inactive lanes go last (ties keep the previous order);
+ *                          lanes with a non-finite x or u are deactivated first
+ *      run()             : geodesic steps with a re-sort every `resort_every`
+ *      gather()          : results back in caller-ID order
+ *
+ * With lattice or cached metric fields, neighbouring lanes then read the same
+ * cells. Per-trajectory results do not depend on the lane order.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+#include "config.hpp"
+#include "linalg.hpp"
+#include "field.hpp"
+#include "parallel.hpp"
+#include "integrators.hpp"
+#include "trace.hpp"
+
+namespace rslm::integ {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::field::IMetricField;
+using rslm::field::IPotential;
+using rslm::field::MetricFieldLike;
+
+// Spread the low 21 bits of v to every third bit.
+inline std::uint64_t morton_spread3(std::uint64_t v) {
+    v &= 0x1fffffull;
+    v = (v | (v << 32)) & 0x1f00000000ffffull;
+    v = (v | (v << 16)) & 0x1f0000ff0000ffull;
+    v = (v | (v <<  8)) & 0x100f00f00f00f00full;
+    v = (v | (v <<  4)) & 0x10c30c30c30c30c3ull;
+    v = (v | (v <<  2)) & 0x1249249249249249ull;
+    return v;
+}
+
+inline std::uint64_t morton3(std::uint32_t ix, std::uint32_t iy, std::uint32_t iz) {
+    return morton_spread3(ix) | (morton_spread3(iy) << 1) | (morton_spread3(iz) << 2);
+}
+
+struct TrajectoryBatch {
+    std::vector<vec4> x, u;                 // per lane
+    std::vector<std::uint32_t> id;          // lane → caller ID
+    std::vector<std::uint32_t> lane;        // caller ID → lane
+    std::vector<std::uint8_t> active;       // per lane
+    std::size_t n_active{0};                // active lanes are [0, n_active) after a sort
+
+    void init(const vec4* x0, const vec4* u0, std::size_t n) {
+        x.assign(x0, x0 + n); u.assign(u0, u0 + n);
+        id.resize(n); lane.resize(n);
+        std::iota(id.begin(), id.end(), 0u);
+        std::iota(lane.begin(), lane.end(), 0u);
+        active.assign(n, 1);
+        n_active = n;
+    }
+
+    std::size_t size() const { return x.size(); }
+
+    // Stop advancing caller trajectory `cid` (takes effect at the next sort).
+    void deactivate(std::uint32_t cid) { active[lane[cid]] = 0; }
+
+    /**
+     * Re-order lanes by Morton key of (x,y,z) over the active lanes' bounding box,
+     * `bits` per axis (≤ 21). Diverged lanes (NaN/Inf in x or u) are deactivated
+     * so they neither poison the box nor keep stepping. Returns the number of
+     * active lanes.
+     */
+    std::size_t sort_spatial(int bits = 10) {
+        const std::size_t n = size();
+        bits = std::clamp(bits, 1, 21);
+        std::size_t diverged = 0;
+        for (std::size_t k=0;k<n;++k) {
+            if (!active[k]) continue;
+            bool finite = true;
+            for (int a=0;a<4;++a) finite = finite && std::isfinite(x[k].v[a]) && std::isfinite(u[k].v[a]);
+            if (!finite) { active[k] = 0; ++diverged; }
+        }
+        if (diverged) TRACE_WARN("traj_lanes_diverged", diverged);
+        real lo[3], hi[3];
+        bool any = false;
+        for (std::size_t k=0;k<n;++k) {
+            if (!active[k]) continue;
+            for (int a=0;a<3;++a) {
+                real v = x[k].v[a+1];
+                if (!any) { lo[a] = hi[a] = v; }
+                else { lo[a] = std::min(lo[a], v); hi[a] = std::max(hi[a], v); }
+            }
+            any = true;
+        }
+        const real cells = real((std::uint64_t(1) << bits) - 1);
+        real scale[3];
+        for (int a=0;a<3;++a) {
+            scale[a] = (any && hi[a] > lo[a]) ? cells / (hi[a] - lo[a]) : real(0);
+            if (!std::isfinite(scale[a])) scale[a] = real(0);          // hi - lo overflowed
+        }
+
+        // (key, lane): inactive lanes get the max key; lane index breaks ties (stable)
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> keys(n);
+        for (std::size_t k=0;k<n;++k) {
+            std::uint64_t key = ~std::uint64_t(0);
+            if (active[k]) {
+                std::uint32_t q[3];
+                for (int a=0;a<3;++a) q[a] = std::uint32_t((x[k].v[a+1] - lo[a]) * scale[a]);
+                key = morton3(q[0], q[1], q[2]);
+            }
+            keys[k] = { key, std::uint32_t(k) };
+        }
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<vec4> nx(n), nu(n);
+        std::vector<std::uint32_t> nid(n);
+        std::vector<std::uint8_t> nact(n);
+        n_active = 0;
+        for (std::size_t k=0;k<n;++k) {
+            std::uint32_t from = keys[k].second;
+            nx[k] = x[from]; nu[k] = u[from]; nid[k] = id[from]; nact[k] = active[from];
+            lane[nid[k]] = std::uint32_t(k);
+            n_active += nact[k];
+        }
+        x.swap(nx); u.swap(nu); id.swap(nid); active.swap(nact);
+        return n_active;
+    }
+
+    // One geodesic step on every active lane.
+    template <MetricFieldLike Fd>
+    void step(const Fd& F, const IPotential* P, real dtau, unsigned threads = 0) {
+        rslm::par::parallel_for(n_active, [&](std::size_t b, std::size_t e) {
+            for (std::size_t k=b;k<e;++k)
+                if (active[k]) geodesic_step(F, P, x[k], u[k], dtau);
+        }, threads, 16);
+    }
+
+    // `steps` steps, re-sorting before the first and then every `resort_every` steps (0 = never).
+    template <MetricFieldLike Fd>
+    void run(const Fd& F, const IPotential* P, real dtau, std::size_t steps,
+             std::size_t resort_every = 16, unsigned threads = 0, int bits = 10)
+    {
+        for (std::size_t s=0;s<steps;++s) {
+            if (resort_every && s % resort_every == 0) sort_spatial(bits);
+            step(F, P, dtau, threads);
+        }
+        TRACE_DEBUG("traj_batch_active", n_active);
+    }
+
+    // Write states back in caller-ID order.
+    void gather(vec4* x_out, vec4* u_out) const {
+        for (std::size_t c=0;c<size();++c) {
+            if (x_out) x_out[c] = x[lane[c]];
+            if (u_out) u_out[c] = u[lane[c]];
+        }
+    }
+};
+
+} // namespace rslm::integ
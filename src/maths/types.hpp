@@ -0,0 +1,194 @@
+#pragma once
+/**
+ * RSLM Maths — types.hpp
+ * ----------------------
+ * Plain data types shared by the kernels, split out so that light headers
+ * (kernels.hpp) can name them without pulling in telemetry, iostreams or
+ * <filesystem>:
+ *   - linalg : vec4, mat4 (row-major), sym4
+ *   - deriv  : DMetric4, DDMetric4 (∂_a g_{μν}, ∂_a∂_b g_{μν})
+ *   - field  : IMetricField, IPotential
+ *   - conn   : Gamma, MetricPack
+ *   - curv   : Riemann
+ *   - phys   : Event, TSParams (stress–energy inputs)
+ *
+ * The operations on these types stay in their modules (linalg.hpp, ...).
+ */
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+#include "config.hpp"
+
+namespace rslm::linalg {
+
+using rslm::cfg::real;
+
+// ----------------------------------------------------------------------------
+// vec4
+// ----------------------------------------------------------------------------
+struct vec4 {
+    std::array<real,4> v{real(0),real(0),real(0),real(0)};
+
+    vec4() = default;
+    vec4(real t, real x, real y, real z) { v[0]=t; v[1]=x; v[2]=y; v[3]=z; }
+    explicit vec4(std::initializer_list<real> a) {
+        std::size_t i=0; for (real e : a) { if (i<4) v[i++]=e; }
+        for (; i<4; ++i) v[i]=real(0);
+    }
+
+    real& operator[](std::size_t i)       { return v[i]; }
+    const real& operator[](std::size_t i) const { return v[i]; }
+};
+
+// ----------------------------------------------------------------------------
+// mat4 (row-major)
+// ----------------------------------------------------------------------------
+struct mat4 {
+    // m[r][c]
+    std::array<std::array<real,4>,4> m{{
+        {{real(0),real(0),real(0),real(0)}},
+        {{real(0),real(0),real(0),real(0)}},
+        {{real(0),real(0),real(0),real(0)}},
+        {{real(0),real(0),real(0),real(0)}},
+    }};
+
+    mat4() = default;
+    explicit mat4(real s) {
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) m[r][c]=(r==c)?s:real(0);
+    }
+    explicit mat4(std::initializer_list<real> a) {
+        int k=0;
+        for (real e : a) { m[k/4][k%4]=e; if (++k==16) break; }
+        for (;k<16;++k) m[k/4][k%4]=real(0);
+    }
+
+    real*       operator[](std::size_t r)       { return m[r].data(); }
+    const real* operator[](std::size_t r) const { return m[r].data(); }
+};
+
+// Symmetric wrapper: builds 0.5*(M + M^T)
+struct sym4 : mat4 {
+    sym4() = default;
+    explicit sym4(const mat4& A) {
+        for (int r=0;r<4;++r) for (int c=0;c<4;++c) {
+            m[r][c] = real(0.5)*(A.m[r][c] + A.m[c][r]);
+        }
+    }
+    static sym4 from_diag(real a0, real a1, real a2, real a3) {
+        sym4 S; for (int i=0;i<4;++i) for (int j=0;j<4;++j) S.m[i][j]=real(0);
+        S.m[0][0]=a0; S.m[1][1]=a1; S.m[2][2]=a2; S.m[3][3]=a3;
+        return S;
+    }
+};
+
+} // namespace rslm::linalg
+
+namespace rslm::deriv {
+
+// Full set of partials: dg[a] = ∂_a g
+struct DMetric4 {
+    rslm::linalg::mat4 dg[4];
+};
+
+// Second partials: ddg[a][b] = ∂_a ∂_b g  (symmetric in a,b and in the matrix indices)
+struct DDMetric4 {
+    rslm::linalg::mat4 ddg[4][4];
+};
+
+} // namespace rslm::deriv
+
+namespace rslm::field {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+using rslm::linalg::sym4;
+
+struct IMetricField {
+    virtual ~IMetricField() = default;
+    virtual sym4 g(const vec4& x) const = 0;
+    // out[k] = g(xs[k]); override when evaluating many points at once is cheaper
+    virtual void g_batch(const vec4* xs, sym4* out, std::size_t n) const {
+        for (std::size_t k=0;k<n;++k) out[k] = g(xs[k]);
+    }
+    // g, ∂g, ∂∂g at x; override with closed-form (or cheaper) derivatives and
+    // return true. The default returns false and deriv::metric_jet falls back
+    // to its 33-point stencil with step h.
+    virtual bool metric_jet(const vec4&, sym4&, rslm::deriv::DMetric4&, rslm::deriv::DDMetric4&, real) const {
+        return false;
+    }
+};
+
+// ∇V by central differences with step h, for any type with V(x)
+template <typename Pt>
+inline vec4 central_grad(const Pt& P, const vec4& x, real h) {
+    vec4 g;
+    for (int a=0;a<4;++a) {
+        vec4 xp = x, xm = x;
+        xp.v[a] += h; xm.v[a] -= h;
+        real vp = P.V(xp);
+        real vm = P.V(xm);
+        g.v[a] = (vp - vm) * (real(0.5)/h);
+    }
+    return g;
+}
+
+struct IPotential {
+    virtual ~IPotential() = default;
+    virtual real V(const vec4& x) const = 0;            // scalar potential
+    // ∇V; default is the central difference with step h, override for closed forms
+    virtual vec4 grad(const vec4& x, real h) const { return central_grad(*this, x, h); }
+};
+
+} // namespace rslm::field
+
+namespace rslm::conn {
+
+using rslm::cfg::real;
+
+struct Gamma {
+    // G[mu][a][b] = Γ^μ_{αβ}
+    real G[4][4][4]{};
+};
+
+struct MetricPack {
+    rslm::linalg::sym4 g;
+    rslm::linalg::mat4 g_inv;
+    rslm::deriv::DMetric4 dg; // ∂_a g
+    bool inv_ok{false};
+};
+
+} // namespace rslm::conn
+
+namespace rslm::curv {
+
+using rslm::cfg::real;
+
+struct Riemann {
+    // R[mu][nu][a][b] = R^μ_{ναβ}
+    real R[4][4][4][4]{};
+};
+
+} // namespace rslm::curv
+
+namespace rslm::phys {
+
+using rslm::cfg::real;
+using rslm::linalg::vec4;
+
+struct Event {
+    vec4 x;     // position (t,x,y,z)
+    vec4 u;     // 4-velocity (approximately timelike, not required normalized)
+    real E{1};  // semantic energy ≥ 0
+    real m{1};  // “rest mass” > 0
+};
+
+struct TSParams {
+    real sigma{1.0};   // kernel width
+    real eta{1e-2};    // stabilizer for g-term
+    real kappa{0.1};   // coupling constant
+    real c2{1.0};
+};
+
+} // namespace rslm::phys
@@ -0,0 +1,33 @@
+/**
+ * RSLM Maths — tools/rslm_bench.cpp
+ * ---------------------------------
+ * Benchmark mode for the runtime-dispatched kernels: reports the variant
+ * selected on this CPU and each variant's speedup over scalar.
+ *
+ *   rslm_bench [n_items] [reps] [--profile]
+ *
+ * --profile installs the per-kernel fastest variants (calibrate()) and
+ * marks those instead of the ISA default.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "dispatch.hpp"
+#include "logger.hpp"
+
+int main(int argc, char** argv) {
+    rslm::telemetry::Logger::instance().set_enabled(false);
+    bool profile = false;
+    std::size_t n = 4096;
+    int reps = 5, pos = 0;
+    for (int i=1;i<argc;++i) {
+        if (std::strcmp(argv[i], "--profile") == 0) { profile = true; continue; }
+        if (pos++ == 0) n = std::size_t(std::strtoull(argv[i], nullptr, 10));
+        else            reps = std::atoi(argv[i]);
+    }
+    auto rows = profile ? rslm::dispatch::calibrate(n, reps) : rslm::dispatch::benchmark(n, reps);
+    rslm::dispatch::print_benchmark(stdout, rows);
+    return 0;
+}
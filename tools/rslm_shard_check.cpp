@@ -0,0 +1,81 @@
+/**
+ * RSLM Maths — tools/rslm_shard_check.cpp
+ * ---------------------------------------
+ * Local multi-process harness for shard.hpp: runs a curvature slice and a
+ * trajectory sweep in-process and sharded over 1..P worker processes, and
+ * checks that the merged results are bitwise identical.
+ *
+ *   rslm_shard_check [max_procs] [grid_n] [n_traj] [steps]
+ *
+ * Exit status 0 when every shard count matches the in-process reference.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "field.hpp"
+#include "grid.hpp"
+#include "integrators.hpp"
+#include "shard.hpp"
+#include "logger.hpp"
+
+using namespace rslm;
+using cfg::real;
+using linalg::vec4;
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    telemetry::Logger::instance().set_enabled(false);
+    std::size_t max_procs = (argc > 1) ? std::size_t(std::strtoull(argv[1], nullptr, 10)) : 4;
+    std::size_t gn        = (argc > 2) ? std::size_t(std::strtoull(argv[2], nullptr, 10)) : 48;
+    std::size_t nt        = (argc > 3) ? std::size_t(std::strtoull(argv[3], nullptr, 10)) : 2000;
+    std::size_t steps     = (argc > 4) ? std::size_t(std::strtoull(argv[4], nullptr, 10)) : 10;
+
+    field::GaussianBumpField F(real(0.05));
+    field::RadialPotential V(real(0.01));
+    const real h = real(4) / real(gn);
+    diag::ScalarFnPtr fn = &diag::curv_scalar;
+
+    auto t0 = std::chrono::steady_clock::now();
+    diag::Grid2D ref = diag::sample_xy(F, 0, 0, -2, -2, h, h, gn, gn, fn);
+    std::printf("grid %zux%zu  in-process  %.3fs\n", gn, gn, seconds_since(t0));
+
+    std::vector<vec4> x0(nt), u0(nt);
+    for (std::size_t k=0;k<nt;++k) {
+        real a = real(k) / real(nt);
+        x0[k] = vec4(0, real(2)*a - 1, real(0.5) - a, real(0.1) * a);
+        u0[k] = vec4(1, real(0.1) * a, 0, 0);
+    }
+    std::vector<vec4> xr = x0, ur = u0;
+    t0 = std::chrono::steady_clock::now();
+    for (std::size_t s=0;s<steps;++s) integ::geodesic_step_batch(F, &V, xr.data(), ur.data(), nt, real(0.05), 1);
+    std::printf("traj %zu x %zu steps  in-process  %.3fs\n", nt, steps, seconds_since(t0));
+
+    bool all_ok = true;
+    for (std::size_t p=1;p<=max_procs;++p) {
+        diag::Grid2D G;
+        t0 = std::chrono::steady_clock::now();
+        bool ok = shard::sample_xy_sharded(G, F, 0, 0, -2, -2, h, h, gn, gn, fn, p);
+        double tg = seconds_since(t0);
+        ok = ok && G.val.size() == ref.val.size()
+                && std::memcmp(G.val.data(), ref.val.data(), ref.val.size() * sizeof(real)) == 0;
+
+        std::vector<vec4> xs = x0, us = u0;
+        t0 = std::chrono::steady_clock::now();
+        bool okt = shard::integrate_sharded(F, &V, xs.data(), us.data(), nt, real(0.05), steps, p, 1);
+        double tt = seconds_since(t0);
+        okt = okt && std::memcmp(xs.data(), xr.data(), nt * sizeof(vec4)) == 0
+                  && std::memcmp(us.data(), ur.data(), nt * sizeof(vec4)) == 0;
+
+        std::printf("procs=%zu  grid %.3fs %s  traj %.3fs %s\n", p, tg, ok ? "match" : "MISMATCH",
+                    tt, okt ? "match" : "MISMATCH");
+        all_ok = all_ok && ok && okt;
+    }
+    return all_ok ? 0 : 1;
+}